@@ -0,0 +1,62 @@
+#include "pch.h"
+#include "TestFramework.h"
+#include "linq.hpp"
+
+using namespace std;
+using namespace TestFramework;
+
+TEST_CLASS_BEGIN( Allocator )
+
+static const vector<int> vec = { 0, 13, 40, 12, 50, 12, 60 };
+
+TEST_METHOD_BEGIN( Arena )
+Linq::Arena arena( 256 );
+auto linq = Linq::From( vec, Linq::ArenaAllocator<int>( arena ) );
+Assert::IsTrue( linq.IsBorrowed() );
+Assert::IsEqual( static_cast<size_t>( 0 ), arena.Allocated() );
+auto query = linq.Where( []( int value ) { return value % 2 == 0; } ).OrderBy().Reverse();
+Assert::IsEqual( vector<int> { 60, 50, 40, 12, 12, 0 }, query.to_vector() );
+Assert::IsTrue( query.GetAllocator() == Linq::ArenaAllocator<int>( arena ) );
+Assert::IsEqual( vec.size() * sizeof( int ), arena.Allocated() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Arena2 )
+Linq::Arena arena( 16 );
+auto linq = Linq::From( vec, Linq::ArenaAllocator<int>( arena ) );
+auto doubles = linq.Select( []( int value ) { return value * 0.5; } );
+Assert::IsEqual( vector<double> { 0.0, 6.5, 20.0, 6.0, 25.0, 6.0, 30.0 }, doubles.to_vector() );
+Assert::IsTrue( doubles.GetAllocator() == Linq::ArenaAllocator<double>( arena ) );
+Assert::IsEqual( vector<int> { 0, 13, 40, 12, 50, 60 }, linq.Distinct().to_vector() );
+Assert::IsEqual( vector<int> { 13, 40, 50 }, linq.Except( Linq::From( vector<int> { 0, 12, 60 }, Linq::ArenaAllocator<int>( arena ) ) ).to_vector() );
+Assert::IsTrue( arena.BlockCount() > 1 );
+arena.Release();
+Assert::IsEqual( static_cast<size_t>( 0 ), arena.BlockCount() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Engines )
+Linq::Arena arena;
+auto linq = Linq::From( vec, Linq::ArenaAllocator<int>( arena ) );
+Assert::IsEqual( 187, linq.Where( []( int value ) { return value > 0; } ).AsParallel().Sum() );
+Assert::IsEqual( static_cast<size_t>( 2 ), linq.Where( []( int value ) { return value > 0; } ).GroupBy( []( int value ) { return value % 2; } ).Count().Count() );
+Assert::IsEqual( vector<int> { 12, 12, 60 }, linq.Join( Linq::From( vector<int> { 12, 60 } ), []( int x ) { return x; }, []( int y ) { return y; }, []( int x, int ) { return x; } ).to_vector() );
+Assert::IsEqual( 1.0, Linq::From( vector<double> { 1.0, 2.0, 3.0 } ).Correlation( Linq::From( vector<double> { 2.0, 4.0, 6.0 }, Linq::ArenaAllocator<double>( arena ) ) ) );
+TEST_METHOD_END
+
+#ifdef __cpp_lib_memory_resource
+TEST_METHOD_BEGIN( Pmr )
+unsigned char buffer[1024];
+pmr::monotonic_buffer_resource resource( buffer, sizeof( buffer ), pmr::null_memory_resource() );
+Linq::PmrVectorable<int> linq = Linq::From( vec, pmr::polymorphic_allocator<int>( &resource ) );
+Assert::IsEqual( vector<int> { 0, 12, 12, 13 }, linq.Where( []( int value ) { return value < 40; } ).OrderBy().to_vector() );
+TEST_METHOD_END
+#endif
+
+TEST_METHOD_BEGIN( InPlace )
+Linq::Arena arena;
+auto linq = Linq::From( vec, Linq::ArenaAllocator<int>( arena ) );
+auto result = linq.Where( []( int value ) { return value > 0; } ).OrderBy().Reverse().Skip( 1 ).Select( []( int value ) { return value + 1; } ).Distinct( equal_to<int>() );
+Assert::IsEqual( vector<int> { 51, 41, 14, 13 }, result.to_vector() );
+Assert::IsEqual( vec.size() * sizeof( int ), arena.Allocated() );
+TEST_METHOD_END
+
+TEST_CLASS_END
\ No newline at end of file
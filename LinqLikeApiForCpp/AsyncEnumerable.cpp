@@ -0,0 +1,107 @@
+#include "pch.h"
+#include "TestFramework.h"
+#include "linq.hpp"
+
+using namespace std;
+using namespace TestFramework;
+
+TEST_CLASS_BEGIN( AsyncEnumerable )
+
+#ifdef LINQ_HAS_COROUTINES
+
+// Pushes first, first + 1, ... last into channel on another thread, then closes it.
+auto produce = []( Linq::Channel<int>& channel, int first, int last, atomic<int>* pushed = nullptr )
+{
+	return thread( [&channel, first, last, pushed]()
+	{
+		for( auto value = first; value <= last; ++value )
+		{
+			if( !channel.Push( value ) )
+			{
+				return;
+			}
+			if( pushed != nullptr )
+			{
+				++*pushed;
+			}
+		}
+		channel.Close();
+	} );
+};
+
+TEST_METHOD_BEGIN( Pipeline )
+Linq::Channel<int> channel( 16 );
+auto producer = produce( channel, 1, 10000 );
+const auto sum = Linq::FromChannel( channel )
+	.Where( []( int value ) { return value % 2 == 0; } )
+	.Select( []( int value ) { return static_cast<long long>( value ) * 3; } )
+	.Sum()
+	.Get();
+producer.join();
+Assert::IsEqual( 75015000LL, sum );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Count )
+Linq::Channel<int> channel( 4 );
+auto producer = produce( channel, 1, 1000 );
+Assert::IsEqual( static_cast<size_t>( 333 ), Linq::FromChannel( channel ).Count( []( int value ) { return value % 3 == 0; } ).Get() );
+producer.join();
+
+Linq::Channel<int> empty( 4 );
+empty.Close();
+Assert::IsEqual( static_cast<size_t>( 0 ), Linq::FromChannel( empty ).Count().Get() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( SkipTake )
+Linq::Channel<int> channel( 8 );
+auto producer = produce( channel, 1, 100 );
+Assert::IsEqual(
+	vector<int> { 11, 12, 13 },
+	Linq::FromChannel( channel ).Skip( 10 ).Take( 3 ).to_vector().Get() );
+channel.Close();
+producer.join();
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Backpressure )
+// The producer is held back by the full buffer once the query stops pulling, instead of running ahead.
+Linq::Channel<int> channel( 4 );
+atomic<int> pushed( 0 );
+auto producer = produce( channel, 1, 1000000, &pushed );
+Assert::IsEqual( vector<int> { 1, 2, 3, 4, 5 }, Linq::FromChannel( channel ).TakeWhile( []( int value ) { return value <= 5; } ).to_vector().Get() );
+this_thread::sleep_for( chrono::milliseconds( 20 ) );
+Assert::IsTrue( pushed.load() <= 6 + 4 );
+channel.Close();
+producer.join();
+Assert::IsTrue( pushed.load() <= 6 + 4 );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( ForEach )
+Linq::Channel<int> channel( 2 );
+auto producer = produce( channel, 1, 10 );
+vector<int> visited;
+Linq::FromChannel( channel ).ForEach( [&visited]( int value ) { visited.push_back( value ); return value < 4; } ).Get();
+Assert::IsEqual( vector<int> { 1, 2, 3, 4 }, visited );
+channel.Close();
+producer.join();
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Exception )
+Linq::Channel<int> channel( 2 );
+auto producer = produce( channel, 1, 10 );
+auto thrown = false;
+try
+{
+	Linq::FromChannel( channel ).Select( []( int value ) { if( value == 3 ) { throw out_of_range( "3" ); } return value; } ).Sum().Get();
+}
+catch( const out_of_range& )
+{
+	thrown = true;
+}
+Assert::IsTrue( thrown );
+channel.Close();
+producer.join();
+TEST_METHOD_END
+
+#endif
+
+TEST_CLASS_END
\ No newline at end of file
@@ -7,7 +7,7 @@ using namespace TestFramework;
 
 TEST_CLASS_BEGIN( BasicCalc )
 
-vector<int> vec = { 0, 13, 40, 12, 50, 12, 60 };
+static const vector<int> vec = { 0, 13, 40, 12, 50, 12, 60 };
 auto linq = Linq::From( vec );
 
 TEST_METHOD_BEGIN( Count )
@@ -26,6 +26,15 @@ TEST_METHOD_BEGIN( Sum )
 Assert::IsEqual( accumulate( cbegin( vec ), cend( vec ), 0 ), linq.Sum() );
 TEST_METHOD_END
 
+TEST_METHOD_BEGIN( Sum2 )
+Assert::IsEqual( 500500LL, Linq::Range( 1LL, 1000LL ).Sum() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Sum3 )
+// Summed in double, so 100000 x 0.1f does not drift like a float left fold does.
+Assert::IsEqual( 10000.0f, Linq::Repeat( 0.1f, 100000 ).Sum() );
+TEST_METHOD_END
+
 TEST_METHOD_BEGIN( Average )
 Assert::IsEqual( accumulate( cbegin( vec ), cend( vec ), 0 ) / static_cast<int>( vec.size() ), linq.Average() );
 TEST_METHOD_END
@@ -50,22 +59,134 @@ TEST_METHOD_BEGIN( Maximum )
 Assert::IsEqual( *max_element( cbegin( vec ), cend( vec ) ), linq.Maximum() );
 TEST_METHOD_END
 
+TEST_METHOD_BEGIN( MinimumMaximum )
+vector<double> doubles( 37 );
+iota( begin( doubles ), end( doubles ), -18.5 );
+doubles[35] = -100.25;
+doubles[36] = 100.25;
+auto longs = Linq::Range( -500LL, 500LL ).Reverse();
+Assert::IsEqual( -100.25, Linq::From( doubles ).Minimum() );
+Assert::IsEqual( 100.25, Linq::From( doubles ).Maximum() );
+Assert::IsEqual( -500LL, longs.Minimum() );
+Assert::IsEqual( 500LL, longs.Maximum() );
+TEST_METHOD_END
+
 TEST_METHOD_BEGIN( Median )
 Assert::IsEqual( static_cast<int>( 13 ), linq.Median() );
 TEST_METHOD_END
 
+TEST_METHOD_BEGIN( Median2 )
+Assert::IsEqual( 2.5, Linq::From( vector<double> { 4.0, 1.0, 3.0, 2.0 } ).Median() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( NthElement )
+Assert::IsEqual( 0, linq.NthElement( 0 ) );
+Assert::IsEqual( 13, linq.NthElement( 3 ) );
+Assert::IsEqual( 60, linq.NthElement( 6 ) );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Quantile )
+Assert::IsEqual( 13, linq.Quantile( 0.5 ) );
+Assert::IsEqual( 45.0, linq.Quantile<double>( 0.75 ) );
+Assert::IsEqual( 991LL, Linq::Range( 1LL, 1001LL ).Reverse().Percentile( 99 ) );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Quantiles )
+Assert::IsEqual( vector<double> { 0.0, 13.0, 45.0, 60.0 }, linq.Quantiles<double>( { 0.0, 0.5, 0.75, 1.0 } ) );
+Assert::IsEqual( vector<int> { 951, 501, 991 }, Linq::Range( 1, 1001 ).Reverse().Quantiles( { 0.95, 0.5, 0.99 } ) );
+TEST_METHOD_END
+
 TEST_METHOD_BEGIN( Variance )
 Assert::IsEqual( static_cast<int>( 452 ), linq.Variance() );
 TEST_METHOD_END
 
+TEST_METHOD_BEGIN( Variance2 )
+Assert::IsEqual( 2.0, Linq::From( vector<double> { 1.0, 2.0, 3.0, 4.0, 5.0 } ).Variance() );
+Assert::IsEqual( 8.25, Linq::Range( 0, 9 ).Select( []( int value ) { return value + 1e9; } ).Variance() );
+TEST_METHOD_END
+
 TEST_METHOD_BEGIN( StandardDeviation )
 Assert::IsEqual( static_cast<int>( 21 ), linq.StandardDeviation() );
 TEST_METHOD_END
 
+TEST_METHOD_BEGIN( Stats )
+const auto stats = linq.Stats();
+Assert::IsEqual( vec.size(), stats.Count() );
+Assert::IsEqual( 187.0, stats.Sum() );
+Assert::IsEqual( 0, stats.Minimum() );
+Assert::IsEqual( 60, stats.Maximum() );
+Assert::IsTrue( abs( stats.Mean() - 187.0 / 7.0 ) < 1e-12 );
+Assert::IsTrue( abs( stats.Variance() - 22130.0 / 49.0 ) < 1e-9 );
+Assert::IsTrue( abs( stats.SampleVariance() - 22130.0 / 42.0 ) < 1e-9 );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Stats2 )
+// A large offset would cancel out sum( x^2 ) - sum( x )^2 / n.
+auto stats = Linq::Range( 0, 9999 ).Select( []( int value ) { return 1e9 + value % 4 * 3; } ).Stats();
+Assert::IsEqual( 1e9 + 4.5, stats.Mean() );
+Assert::IsEqual( 11.25, stats.Variance() );
+Assert::IsEqual( 1e9, stats.Minimum() );
+Assert::IsEqual( 1e9 + 9, stats.Maximum() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( GeometricMean )
+Assert::IsTrue( abs( Linq::From( vector<int> { 2, 8 } ).GeometricMean<double>() - 4.0 ) < 1e-12 );
+Assert::IsTrue( abs( Linq::From( vector<double> { 1.0, 3.0, 9.0 } ).GeometricAverage() - 3.0 ) < 1e-12 );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( StatsMeans )
+// Over several blocks of Stats, and by Add, the same as GeometricMean and HarmonicMean.
+vector<double> values;
+for( size_t i = 0; i < 10000; ++i )
+{
+	values.push_back( i % 2 == 0 ? 2.0 : 8.0 );
+}
+const auto stats = Linq::From( values ).Stats();
+Assert::IsTrue( abs( stats.GeometricMean() - 4.0 ) < 1e-9 );
+Assert::IsTrue( abs( stats.HarmonicMean() - 3.2 ) < 1e-9 );
+Linq::Statistics<int> added;
+added.Add( 2 );
+added.Add( 8 );
+Assert::IsTrue( abs( added.GeometricMean() - 4.0 ) < 1e-12 );
+Assert::IsTrue( abs( added.HarmonicMean() - 3.2 ) < 1e-12 );
+Assert::IsTrue( isnan( Linq::Statistics<int>().GeometricMean() ) );
+Assert::IsTrue( isnan( Linq::Statistics<int>().HarmonicMean() ) );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( HarmonicMean )
+Assert::IsTrue( abs( Linq::From( vector<double> { 2.0, 6.0, 3.0 } ).HarmonicMean() - 3.0 ) < 1e-12 );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Covariance )
+auto x = Linq::From( vector<int> { 1, 2, 3, 4 } );
+Assert::IsEqual( 2.5, x.Covariance( Linq::From( vector<double> { 2.0, 4.0, 6.0, 8.0 } ) ) );
+Assert::IsTrue( abs( x.Correlation( Linq::From( vector<int> { 8, 6, 4, 2 } ) ) + 1.0 ) < 1e-12 );
+Assert::IsTrue( isnan( Linq::BivariateStatistics().Covariance() ) );
+Assert::IsTrue( isnan( Linq::BivariateStatistics().Correlation() ) );
+TEST_METHOD_END
+
 TEST_METHOD_BEGIN( Aggregate )
 Assert::IsEqual(
 	accumulate( cbegin( vec ), cend( vec ), 1, ::std::multiplies<int>() ),
 	linq.Aggregate( 1, []( int x, int y ) { return x * y; } ) );
 TEST_METHOD_END
 
+TEST_METHOD_BEGIN( Sorted )
+// Answered by binary search and from the ends, and the same as on the unsorted sequence.
+auto ascending = linq.OrderBy();
+auto descending = linq.OrderByDescending();
+Assert::IsEqual( linq.Median(), ascending.Median() );
+Assert::IsEqual( linq.Median(), descending.Median() );
+Assert::IsEqual( linq.Skip( 1 ).Median(), linq.Skip( 1 ).OrderByDescending().Median() );
+Assert::IsEqual( linq.Skip( 1 ).Median(), linq.Skip( 1 ).OrderBy().Median() );
+Assert::IsEqual( 0, descending.Minimum() );
+Assert::IsEqual( 60, descending.Maximum() );
+Assert::IsEqual( 60, ascending.Maximum() );
+Assert::IsTrue( ascending.Contain( 13 ) && descending.Contain( 13 ) );
+Assert::IsFalse( ascending.Contain( 14 ) || descending.Contain( 14 ) );
+Assert::IsEqual( static_cast<size_t>( 2 ), ascending.Count( 12 ) );
+Assert::IsEqual( static_cast<size_t>( 2 ), descending.Count( 12 ) );
+Assert::IsEqual( static_cast<size_t>( 0 ), descending.Count( 11 ) );
+TEST_METHOD_END
+
 TEST_CLASS_END
\ No newline at end of file
@@ -1,4 +1,4 @@
-#include "pch.h"
+﻿#include "pch.h"
 #include "TestFramework.h"
 #include "linq.hpp"
 
@@ -7,7 +7,7 @@ using namespace TestFramework;
 
 TEST_CLASS_BEGIN( BasicOperation )
 
-vector<int> vec = { 0, 13, 40, 12, 50, 12, 60 };
+static const vector<int> vec = { 0, 13, 40, 12, 50, 12, 60 };
 auto linq = Linq::From( vec );
 
 TEST_METHOD_BEGIN( Skip )
@@ -42,8 +42,105 @@ TEST_METHOD_BEGIN( OrderBy2 )
 Assert::IsEqual( vector<int> { 60, 50, 40, 13, 12, 12, 0 }, linq.OrderBy( greater<int>() ).to_vector() );
 TEST_METHOD_END
 
+TEST_METHOD_BEGIN( OrderBy3 )
+Assert::IsEqual( vector<int> { 60, 50, 40, 13, 12, 12, 0 }, linq.OrderBy( greater<>() ).to_vector() );
+TEST_METHOD_END
+
 TEST_METHOD_BEGIN( OrderByDescending )
 Assert::IsEqual( vector<int> { 60, 50, 40, 13, 12, 12, 0 }, linq.OrderByDescending().to_vector() );
 TEST_METHOD_END
 
+TEST_METHOD_BEGIN( InPlace )
+Assert::IsEqual( vector<int> { 50, 40, 13, 12, 12 }, linq.Reverse().Skip( 1 ).Take( 5 ).OrderByDescending().to_vector() );
+Assert::IsEqual( vector<int> { 12, 50, 12 }, linq.Rotate( 1 ).SkipWhile( []( int value ) { return value != 12; } ).TakeWhile( []( int value ) { return value < 60; } ).to_vector() );
+Assert::IsEqual( vector<int> { 0, 12, 13 }, linq.Where( []( int value ) { return value < 40; } ).Distinct().OrderBy().to_vector() );
+Assert::IsEqual( vector<int> { 0, 26, 80, 24 }, linq.Take( 4 ).Select( []( int value ) { return value * 2; } ).to_vector() );
+Assert::IsEqual( vector<int> { 0, 13, 40, 12, 50, 12, 60, 60 }, linq.Reverse().Reverse().Concat( linq.Skip( 6 ) ).to_vector() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Ordering )
+auto sorted = linq.OrderBy();
+Assert::IsTrue( Linq::Ordering::Ascending == sorted.GetOrdering() );
+Assert::IsTrue( Linq::Ordering::Ascending == sorted.Where( []( int value ) { return value > 0; } ).Skip( 1 ).Take( 4 ).Distinct().GetOrdering() );
+Assert::IsTrue( Linq::Ordering::Descending == sorted.Reverse().GetOrdering() );
+Assert::IsTrue( Linq::Ordering::Descending == linq.OrderBy( greater<int>() ).GetOrdering() );
+Assert::IsTrue( Linq::Ordering::None == linq.OrderBy( []( int x, int y ) { return x < y; } ).GetOrdering() );
+Assert::IsTrue( Linq::Ordering::None == sorted.Rotate( 1 ).GetOrdering() );
+Assert::IsTrue( Linq::Ordering::None == linq.OrderBy().Select( []( int value ) { return -value; } ).GetOrdering() );
+Assert::IsTrue( Linq::Ordering::None == linq.Where( []( int value ) { return value > 0; } ).GetOrdering() );
+auto mutated = linq.OrderBy();
+*mutated.Begin() = 100;
+Assert::IsTrue( Linq::Ordering::None == mutated.GetOrdering() );
+// ::std::less<int> does not sort doubles by their value, so it gives no Ordering.
+auto truncated = Linq::From( vector<double> { 1.5, 1.2, 2.7, 2.1 } ).OrderBy( less<int>() );
+Assert::IsTrue( Linq::Ordering::None == truncated.GetOrdering() );
+Assert::IsTrue( truncated.Contain( 2.1 ) );
+Assert::IsTrue( Linq::Ordering::Ascending == Linq::From( vector<double> { 1.5, 1.2 } ).OrderBy( less<double>() ).GetOrdering() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( RadixSort )
+// Enough elements for the radix sort: negative, positive and mixed magnitude keys must come out as ::std::sort orders them.
+vector<long long> integers;
+vector<double> doubles;
+vector<unsigned char> bytes;
+uint64_t state = 88172645463325252ull;
+for( size_t i = 0; i < 5000; ++i )
+{
+	state ^= state << 13;
+	state ^= state >> 7;
+	state ^= state << 17;
+	integers.push_back( static_cast<long long>( state ) >> ( i % 40 ) );
+	doubles.push_back( static_cast<double>( static_cast<long long>( state ) >> ( i % 60 ) ) / 1024.0 );
+	bytes.push_back( static_cast<unsigned char>( state ) );
+}
+doubles[7] = -0.0;
+doubles[8] = numeric_limits<double>::infinity();
+doubles[9] = -numeric_limits<double>::infinity();
+
+auto expectedIntegers = integers;
+sort( begin( expectedIntegers ), end( expectedIntegers ) );
+Assert::IsEqual( expectedIntegers, Linq::From( integers ).OrderBy().to_vector() );
+sort( begin( expectedIntegers ), end( expectedIntegers ), greater<long long>() );
+Assert::IsEqual( expectedIntegers, Linq::From( integers ).OrderByDescending().to_vector() );
+
+auto expectedDoubles = doubles;
+sort( begin( expectedDoubles ), end( expectedDoubles ) );
+Assert::IsEqual( expectedDoubles, Linq::From( doubles ).OrderBy( less<double>() ).to_vector() );
+sort( begin( expectedDoubles ), end( expectedDoubles ), greater<>() );
+Assert::IsEqual( expectedDoubles, Linq::From( doubles ).OrderBy( greater<>() ).to_vector() );
+
+auto expectedBytes = bytes;
+sort( begin( expectedBytes ), end( expectedBytes ) );
+Assert::IsEqual( expectedBytes, Linq::From( bytes ).OrderBy().to_vector() );
+Assert::IsEqual( expectedBytes[2500], Linq::From( bytes ).Median() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( OrderByKey )
+// Stable: the elements with the same key keep their order.
+Assert::IsEqual( vector<int> { 0, 40, 50, 60, 12, 12, 13 }, linq.OrderBy( []( int value ) { return value % 10; } ).to_vector() );
+Assert::IsEqual( vector<int> { 13, 12, 12, 0, 40, 50, 60 }, linq.OrderByDescending( []( int value ) { return value % 10; } ).to_vector() );
+Assert::IsEqual( vector<int> { 60, 50, 40, 0, 12, 12, 13 }, linq.OrderBy( []( int value ) { return value % 10; } ).ThenByDescending( []( int value ) { return value; } ).to_vector() );
+
+const vector<pair<string, int>> people = { { "carol", 30 }, { "alice", 25 }, { "bob", 30 }, { "dave", 25 }, { "erin", 35 } };
+size_t calls = 0;
+auto sorted = Linq::From( people )
+	.OrderByDescending( [&calls]( const pair<string, int>& person ) { ++calls; return person.second; } )
+	.ThenBy( []( const pair<string, int>& person ) { return person.first; } )
+	.ToVectorable();
+Assert::IsEqual( vector<string> { "erin", "bob", "carol", "alice", "dave" }, sorted.to_vector( []( const pair<string, int>& person ) { return person.first; } ) );
+Assert::IsEqual( people.size(), calls );
+Assert::IsTrue( Linq::Ordering::None == sorted.GetOrdering() );
+
+// Enough elements for the radix sort of the keys, which must be stable as well.
+vector<pair<int, size_t>> many;
+for( size_t i = 0; i < 5000; ++i )
+{
+	many.emplace_back( static_cast<int>( ( i * 7919 ) % 101 ) - 50, i );
+}
+auto expected = many;
+stable_sort( begin( expected ), end( expected ), []( const pair<int, size_t>& x, const pair<int, size_t>& y ) { return x.first > y.first; } );
+Assert::IsTrue( expected == Linq::From( many ).OrderByDescending( []( const pair<int, size_t>& value ) { return value.first; } ).to_vector() );
+Assert::IsEqual( vector<int> { 12, 12, 0 }, Linq::AsEnumerable( vec ).Where( []( int value ) { return value < 13; } ).OrderBy( []( int value ) { return -value; } ).ThenBy( []( int value ) { return value; } ).to_vector() );
+TEST_METHOD_END
+
 TEST_CLASS_END
\ No newline at end of file
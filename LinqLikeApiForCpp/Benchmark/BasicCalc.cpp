@@ -0,0 +1,63 @@
+#include "BenchmarkFramework.h"
+#include "../linq.hpp"
+
+namespace Benchmark {
+
+	namespace {
+
+		template<typename T>
+		struct BasicCalc
+		{
+			static void Run( const Options& options, const ::std::vector<T>& data )
+			{
+				const auto pivot = data[data.size() / 2];
+
+				Compare( options, "BasicCalc", "Count(predicate)", data,
+					[&data, &pivot]() { return Linq::From( data ).Count( [&pivot]( const T& value ) { return value < pivot; } ); },
+					[&data, &pivot]() { return ::std::count_if( data.begin(), data.end(), [&pivot]( const T& value ) { return value < pivot; } ); } );
+
+				RunArithmetic( options, data, ::std::is_arithmetic<T>() );
+			}
+
+			static void RunArithmetic( const Options&, const ::std::vector<T>&, ::std::false_type ) { }
+
+			static void RunArithmetic( const Options& options, const ::std::vector<T>& data, ::std::true_type )
+			{
+				Compare( options, "BasicCalc", "Sum", data,
+					[&data]() { return Linq::From( data ).Sum(); },
+					[&data]() { return ::std::accumulate( data.begin(), data.end(), static_cast<T>( 0 ) ); } );
+				Compare( options, "BasicCalc", "Average", data,
+					[&data]() { return Linq::From( data ).Average(); },
+					[&data]() { return ::std::accumulate( data.begin(), data.end(), static_cast<T>( 0 ) ) / static_cast<T>( data.size() ); } );
+				Compare( options, "BasicCalc", "Minimum", data,
+					[&data]() { return Linq::From( data ).Minimum(); },
+					[&data]() { return *::std::min_element( data.begin(), data.end() ); } );
+				Compare( options, "BasicCalc", "Median", data,
+					[&data]() { return Linq::From( data ).Median(); },
+					[&data]()
+					{
+						auto values = data;
+						const auto nth = values.begin() + values.size() / 2;
+						::std::nth_element( values.begin(), nth, values.end() );
+						return *nth;
+					} );
+				Compare( options, "BasicCalc", "Variance", data,
+					[&data]() { return Linq::From( data ).Variance(); },
+					[&data]()
+					{
+						const auto average = ::std::accumulate( data.begin(), data.end(), static_cast<T>( 0 ) ) / static_cast<T>( data.size() );
+						T ret = 0;
+						for( const auto value : data )
+						{
+							ret += ( value - average ) * ( value - average );
+						}
+						return ret / static_cast<T>( data.size() );
+					} );
+			}
+		};
+
+	}
+
+	void RunBasicCalc( const Options& options ) { Run<BasicCalc>( options, "BasicCalc" ); }
+
+}
@@ -0,0 +1,56 @@
+#include "BenchmarkFramework.h"
+#include "../linq.hpp"
+
+namespace Benchmark {
+
+	namespace {
+
+		template<typename T>
+		struct BasicOperation
+		{
+			static void Run( const Options& options, const ::std::vector<T>& data )
+			{
+				const auto half = data.size() / 2;
+
+				Compare( options, "BasicOperation", "Skip", data,
+					[&data, half]() { return Linq::From( data ).Skip( half ); },
+					[&data, half]() { return ::std::vector<T>( data.begin() + half, data.end() ); } );
+				Compare( options, "BasicOperation", "Take", data,
+					[&data, half]() { return Linq::From( data ).Take( half ); },
+					[&data, half]() { return ::std::vector<T>( data.begin(), data.begin() + half ); } );
+				Compare( options, "BasicOperation", "Reverse", data,
+					[&data]() { return Linq::From( data ).Reverse(); },
+					[&data]() { return ::std::vector<T>( data.rbegin(), data.rend() ); } );
+				Compare( options, "BasicOperation", "Rotate", data,
+					[&data, half]() { return Linq::From( data ).Rotate( half ); },
+					[&data, half]()
+					{
+						::std::vector<T> ret( data.size() );
+						::std::rotate_copy( data.begin(), data.begin() + half, data.end(), ret.begin() );
+						return ret;
+					} );
+				Compare( options, "BasicOperation", "OrderBy", data,
+					[&data]() { return Linq::From( data ).OrderBy(); },
+					[&data]()
+					{
+						auto ret = data;
+						::std::sort( ret.begin(), ret.end() );
+						return ret;
+					} );
+				Compare( options, "BasicOperation", "OrderBy.Reverse", data,
+					[&data]() { return Linq::From( data ).OrderBy().Reverse(); },
+					[&data]()
+					{
+						auto ret = data;
+						::std::sort( ret.begin(), ret.end() );
+						::std::reverse( ret.begin(), ret.end() );
+						return ret;
+					} );
+			}
+		};
+
+	}
+
+	void RunBasicOperation( const Options& options ) { Run<BasicOperation>( options, "BasicOperation" ); }
+
+}
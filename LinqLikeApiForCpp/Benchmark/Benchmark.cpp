@@ -0,0 +1,41 @@
+#include "BenchmarkFramework.h"
+#include <cstdio>
+#include <cstdlib>
+
+namespace Benchmark {
+
+	void RunGetter( const Options& options );
+	void RunConditionalJudgement( const Options& options );
+	void RunBasicCalc( const Options& options );
+	void RunFiltering( const Options& options );
+	void RunBasicOperation( const Options& options );
+	void RunSetCalc( const Options& options );
+	void RunConversion( const Options& options );
+	void RunVectorlize( const Options& options );
+
+}
+
+// llabench [max size = 1000000] [family]
+// The sizes go from 1e3 to max size by powers of ten; pass 100000000 for the full sweep.
+int main( int argc, char* args[] )
+{
+	Benchmark::Options options;
+	options.minSize = 1000;
+	options.maxSize = argc > 1 ? static_cast<::std::size_t>( ::std::strtod( args[1], nullptr ) ) : 1000000;
+	options.minSeconds = 0.05;
+	options.family = argc > 2 ? args[2] : "";
+
+	::std::printf(
+		"%-22s %-18s %-7s %10s %10s %10s %9s %14s %14s\n",
+		"family", "operator", "type", "elements", "linq ns/e", "stl ns/e", "ratio", "linq bytes", "stl bytes" );
+
+	Benchmark::RunGetter( options );
+	Benchmark::RunConditionalJudgement( options );
+	Benchmark::RunBasicCalc( options );
+	Benchmark::RunFiltering( options );
+	Benchmark::RunBasicOperation( options );
+	Benchmark::RunSetCalc( options );
+	Benchmark::RunConversion( options );
+	Benchmark::RunVectorlize( options );
+	return 0;
+}
@@ -0,0 +1,65 @@
+#include "BenchmarkFramework.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+	::std::atomic<::std::size_t> allocatedBytes( 0 );
+
+#if !defined( __GNUC__ ) && !defined( __clang__ )
+	// A store to a volatile global cannot be removed, so the pointer (and what it points to) must be computed.
+	const void* volatile escaped = nullptr;
+#endif
+
+}
+
+// Every allocation of the benchmark binary goes through here, so the bytes of the Linq and of the STL version can be compared.
+void* operator new( ::std::size_t size )
+{
+	allocatedBytes.fetch_add( size, ::std::memory_order_relaxed );
+	if( auto ptr = ::std::malloc( size != 0 ? size : 1 ) )
+	{
+		return ptr;
+	}
+	throw ::std::bad_alloc();
+}
+
+void operator delete( void* ptr ) noexcept { ::std::free( ptr ); }
+void operator delete( void* ptr, ::std::size_t ) noexcept { ::std::free( ptr ); }
+
+namespace Benchmark {
+
+	::std::size_t AllocatedBytes()
+	{
+		return allocatedBytes.load( ::std::memory_order_relaxed );
+	}
+
+	// An empty asm which takes the pointer and clobbers memory, so the compiler has to materialize the result behind it.
+	void Escape( const void* pointer )
+	{
+#if defined( __GNUC__ ) || defined( __clang__ )
+		asm volatile( "" : : "g"( pointer ) : "memory" );
+#else
+		escaped = pointer;
+#endif
+	}
+
+	void Report( const char* family, const char* name, const char* type, ::std::size_t count, const Measurement& linq, const Measurement& stl )
+	{
+		::std::printf(
+			"%-22s %-18s %-7s %10zu %10.3f %10.3f %8.2fx %14zu %14zu\n",
+			family,
+			name,
+			type,
+			count,
+			linq.nanosecondsPerElement,
+			stl.nanosecondsPerElement,
+			stl.nanosecondsPerElement > 0.0 ? linq.nanosecondsPerElement / stl.nanosecondsPerElement : 0.0,
+			linq.bytes,
+			stl.bytes );
+		::std::fflush( stdout );
+	}
+
+}
@@ -0,0 +1,119 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Benchmark {
+
+	struct Options
+	{
+		::std::size_t minSize;
+		::std::size_t maxSize;
+		double minSeconds;
+		::std::string family;
+	};
+
+	struct Measurement
+	{
+		double nanosecondsPerElement;
+		::std::size_t bytes;
+	};
+
+	// The bytes requested from the global operator new since the program started (all threads).
+	::std::size_t AllocatedBytes();
+
+	// Makes the optimizer assume that the result is used.
+	void Escape( const void* pointer );
+	template<typename R> void Consume( const R& result ) { Escape( &result ); }
+
+	void Report( const char* family, const char* name, const char* type, ::std::size_t count, const Measurement& linq, const Measurement& stl );
+
+	// The best time of func() over repetitions which last at least minSeconds, and the bytes allocated by one call.
+	template<typename Func>
+	Measurement Measure( ::std::size_t count, double minSeconds, Func func )
+	{
+		using Clock = ::std::chrono::steady_clock;
+
+		const auto before = AllocatedBytes();
+		Consume( func() );
+		const auto bytes = AllocatedBytes() - before;
+
+		auto best = ::std::numeric_limits<double>::infinity();
+		const auto start = Clock::now();
+		do
+		{
+			const auto begin = Clock::now();
+			Consume( func() );
+			const auto end = Clock::now();
+			best = ::std::min( best, static_cast<double>( ::std::chrono::duration_cast<::std::chrono::nanoseconds>( end - begin ).count() ) );
+		} while( ::std::chrono::duration<double>( Clock::now() - start ).count() < minSeconds );
+
+		return Measurement { best / static_cast<double>( ::std::max( count, static_cast<::std::size_t>( 1 ) ) ), bytes };
+	}
+
+	template<typename T> struct TypeName;
+	template<> struct TypeName<int> { static const char* Get() { return "int"; } };
+	template<> struct TypeName<double> { static const char* Get() { return "double"; } };
+	template<> struct TypeName<::std::string> { static const char* Get() { return "string"; } };
+
+	// The Linq and the hand-written STL version of one operator on the same data.
+	template<typename T, typename LinqFunc, typename StlFunc>
+	void Compare( const Options& options, const char* family, const char* name, const ::std::vector<T>& data, LinqFunc linq, StlFunc stl )
+	{
+		const auto count = data.size();
+		Report( family, name, TypeName<T>::Get(), count, Measure( count, options.minSeconds, linq ), Measure( count, options.minSeconds, stl ) );
+	}
+
+	// Pseudo-random values in [0, count), so that about 37% of them are duplicates.
+	template<typename T> T MakeValue( ::std::size_t value ) { return static_cast<T>( value ); }
+	template<> inline double MakeValue( ::std::size_t value ) { return static_cast<double>( value ) + 0.5; }
+	template<> inline ::std::string MakeValue( ::std::size_t value ) { return "value" + ::std::to_string( value ); }
+
+	template<typename T>
+	::std::vector<T> MakeData( ::std::size_t count )
+	{
+		::std::vector<T> ret;
+		ret.reserve( count );
+		::std::uint64_t state = 88172645463325252ull;
+		for( ::std::size_t i = 0; i < count; ++i )
+		{
+			state ^= state << 13;
+			state ^= state >> 7;
+			state ^= state << 17;
+			ret.push_back( MakeValue<T>( static_cast<::std::size_t>( state % count ) ) );
+		}
+		return ret;
+	}
+
+	// A value which is not in the data.
+	template<typename T> T Missing() { return MakeValue<T>( static_cast<::std::size_t>( -1 ) ); }
+
+	// A map which works for numbers and strings alike.
+	struct Twice
+	{
+		template<typename T> T operator()( const T& value ) const { return value + value; }
+	};
+
+	// Runs Family<T>::Run( options, data ) for int, double and std::string at every power of ten in [minSize, maxSize].
+	template<template<typename> class Family>
+	void Run( const Options& options, const char* family )
+	{
+		if( !options.family.empty() && options.family != family )
+		{
+			return;
+		}
+
+		for( auto count = options.minSize; count <= options.maxSize; count *= 10 )
+		{
+			Family<int>::Run( options, MakeData<int>( count ) );
+			Family<double>::Run( options, MakeData<double>( count ) );
+			Family<::std::string>::Run( options, MakeData<::std::string>( count ) );
+		}
+	}
+
+}
@@ -0,0 +1,31 @@
+#include "BenchmarkFramework.h"
+#include "../linq.hpp"
+
+namespace Benchmark {
+
+	namespace {
+
+		template<typename T>
+		struct ConditionalJudgement
+		{
+			static void Run( const Options& options, const ::std::vector<T>& data )
+			{
+				const auto missing = Missing<T>();
+
+				Compare( options, "ConditionalJudgement", "All", data,
+					[&data, &missing]() { return Linq::From( data ).All( [&missing]( const T& value ) { return !( value == missing ); } ); },
+					[&data, &missing]() { return ::std::all_of( data.begin(), data.end(), [&missing]( const T& value ) { return !( value == missing ); } ); } );
+				Compare( options, "ConditionalJudgement", "Any", data,
+					[&data, &missing]() { return Linq::From( data ).Any( [&missing]( const T& value ) { return value == missing; } ); },
+					[&data, &missing]() { return ::std::any_of( data.begin(), data.end(), [&missing]( const T& value ) { return value == missing; } ); } );
+				Compare( options, "ConditionalJudgement", "Contain", data,
+					[&data, &missing]() { return Linq::From( data ).Contain( missing ); },
+					[&data, &missing]() { return ::std::find( data.begin(), data.end(), missing ) != data.end(); } );
+			}
+		};
+
+	}
+
+	void RunConditionalJudgement( const Options& options ) { Run<ConditionalJudgement>( options, "ConditionalJudgement" ); }
+
+}
@@ -0,0 +1,59 @@
+#include "BenchmarkFramework.h"
+#include "../linq.hpp"
+
+namespace Benchmark {
+
+	namespace {
+
+		template<typename T>
+		struct Conversion
+		{
+			static void Run( const Options& options, const ::std::vector<T>& data )
+			{
+				Compare( options, "Conversion", "Select", data,
+					[&data]() { return Linq::From( data ).Select( Twice() ); },
+					[&data]()
+					{
+						::std::vector<T> ret( data.size() );
+						::std::transform( data.begin(), data.end(), ret.begin(), Twice() );
+						return ret;
+					} );
+				Compare( options, "Conversion", "Where.Select", data,
+					[&data]() { return Linq::From( data ).Where( []( const T& value ) { return !( value == Missing<T>() ); } ).Select( Twice() ); },
+					[&data]()
+					{
+						::std::vector<T> ret;
+						ret.reserve( data.size() );
+						for( const auto& value : data )
+						{
+							if( !( value == Missing<T>() ) )
+							{
+								ret.push_back( Twice()( value ) );
+							}
+						}
+						return ret;
+					} );
+
+				RunArithmetic( options, data, ::std::is_arithmetic<T>() );
+			}
+
+			static void RunArithmetic( const Options&, const ::std::vector<T>&, ::std::false_type ) { }
+
+			static void RunArithmetic( const Options& options, const ::std::vector<T>& data, ::std::true_type )
+			{
+				Compare( options, "Conversion", "Cast<float>", data,
+					[&data]() { return Linq::From( data ).template Cast<float>(); },
+					[&data]()
+					{
+						::std::vector<float> ret( data.size() );
+						::std::transform( data.begin(), data.end(), ret.begin(), []( T value ) { return static_cast<float>( value ); } );
+						return ret;
+					} );
+			}
+		};
+
+	}
+
+	void RunConversion( const Options& options ) { Run<Conversion>( options, "Conversion" ); }
+
+}
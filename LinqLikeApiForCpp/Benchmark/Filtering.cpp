@@ -0,0 +1,40 @@
+#include "BenchmarkFramework.h"
+#include "../linq.hpp"
+
+namespace Benchmark {
+
+	namespace {
+
+		template<typename T>
+		struct Filtering
+		{
+			static void Run( const Options& options, const ::std::vector<T>& data )
+			{
+				const auto pivot = data[data.size() / 2];
+
+				Compare( options, "Filtering", "Where", data,
+					[&data, &pivot]() { return Linq::From( data ).Where( [&pivot]( const T& value ) { return value < pivot; } ); },
+					[&data, &pivot]()
+					{
+						::std::vector<T> ret;
+						ret.reserve( data.size() );
+						::std::copy_if( data.begin(), data.end(), ::std::back_inserter( ret ), [&pivot]( const T& value ) { return value < pivot; } );
+						return ret;
+					} );
+				Compare( options, "Filtering", "EqualTo", data,
+					[&data, &pivot]() { return Linq::From( data ).EqualTo( pivot ); },
+					[&data, &pivot]()
+					{
+						::std::vector<T> ret;
+						ret.reserve( data.size() );
+						::std::copy_if( data.begin(), data.end(), ::std::back_inserter( ret ), [&pivot]( const T& value ) { return value == pivot; } );
+						return ret;
+					} );
+			}
+		};
+
+	}
+
+	void RunFiltering( const Options& options ) { Run<Filtering>( options, "Filtering" ); }
+
+}
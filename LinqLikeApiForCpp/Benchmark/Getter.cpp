@@ -0,0 +1,45 @@
+#include "BenchmarkFramework.h"
+#include "../linq.hpp"
+
+namespace Benchmark {
+
+	namespace {
+
+		template<typename T>
+		struct Getter
+		{
+			static void Run( const Options& options, const ::std::vector<T>& data )
+			{
+				const auto last = data.back();
+
+				Compare( options, "Getter", "At", data,
+					[&data]()
+					{
+						const auto linq = Linq::From( data );
+						::std::size_t ret = 0;
+						for( ::std::size_t i = 0; i < linq.Count(); ++i )
+						{
+							ret += linq.At( i ) < data[0] ? 1 : 0;
+						}
+						return ret;
+					},
+					[&data]()
+					{
+						::std::size_t ret = 0;
+						for( ::std::size_t i = 0; i < data.size(); ++i )
+						{
+							ret += data.at( i ) < data[0] ? 1 : 0;
+						}
+						return ret;
+					} );
+				Compare( options, "Getter", "First(predicate)", data,
+					[&data, &last]() { return Linq::From( data ).First( [&last]( const T& value ) { return value == last; } ); },
+					[&data, &last]() { return *::std::find_if( data.begin(), data.end(), [&last]( const T& value ) { return value == last; } ); } );
+			}
+		};
+
+	}
+
+	void RunGetter( const Options& options ) { Run<Getter>( options, "Getter" ); }
+
+}
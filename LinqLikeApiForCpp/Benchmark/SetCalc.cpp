@@ -0,0 +1,68 @@
+#include "BenchmarkFramework.h"
+#include "../linq.hpp"
+#include <unordered_set>
+
+namespace Benchmark {
+
+	namespace {
+
+		template<typename T>
+		struct SetCalc
+		{
+			static void Run( const Options& options, const ::std::vector<T>& data )
+			{
+				const ::std::vector<T> second( data.begin(), data.begin() + data.size() / 2 );
+
+				Compare( options, "SetCalc", "Distinct", data,
+					[&data]() { return Linq::From( data ).Distinct(); },
+					[&data]()
+					{
+						::std::unordered_set<T> seen( data.size() );
+						::std::vector<T> ret;
+						for( const auto& value : data )
+						{
+							if( seen.insert( value ).second )
+							{
+								ret.push_back( value );
+							}
+						}
+						return ret;
+					} );
+				Compare( options, "SetCalc", "Intersect", data,
+					[&data, &second]() { return Linq::From( data ).Intersect( Linq::From( second ) ); },
+					[&data, &second]()
+					{
+						::std::unordered_set<T> rest( second.begin(), second.end() );
+						::std::vector<T> ret;
+						for( const auto& value : data )
+						{
+							if( rest.erase( value ) != 0 )
+							{
+								ret.push_back( value );
+							}
+						}
+						return ret;
+					} );
+				Compare( options, "SetCalc", "Except", data,
+					[&data, &second]() { return Linq::From( data ).Except( Linq::From( second ) ); },
+					[&data, &second]()
+					{
+						::std::unordered_set<T> seen( second.begin(), second.end() );
+						::std::vector<T> ret;
+						for( const auto& value : data )
+						{
+							if( seen.insert( value ).second )
+							{
+								ret.push_back( value );
+							}
+						}
+						return ret;
+					} );
+			}
+		};
+
+	}
+
+	void RunSetCalc( const Options& options ) { Run<SetCalc>( options, "SetCalc" ); }
+
+}
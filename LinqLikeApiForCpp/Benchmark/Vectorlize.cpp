@@ -0,0 +1,37 @@
+#include "BenchmarkFramework.h"
+#include "../linq.hpp"
+
+namespace Benchmark {
+
+	namespace {
+
+		template<typename T>
+		struct Vectorlize
+		{
+			static void Run( const Options& options, const ::std::vector<T>& data )
+			{
+				Compare( options, "Vectorlize/Maplize", "to_vector", data,
+					[&data]() { return Linq::From( data ).to_vector(); },
+					[&data]() { return ::std::vector<T>( data ); } );
+				Compare( options, "Vectorlize/Maplize", "AsEnumerable", data,
+					[&data]() { return Linq::From( data ).AsEnumerable().Where( []( const T& value ) { return !( value == Missing<T>() ); } ).to_vector(); },
+					[&data]()
+					{
+						::std::vector<T> ret;
+						for( const auto& value : data )
+						{
+							if( !( value == Missing<T>() ) )
+							{
+								ret.push_back( value );
+							}
+						}
+						return ret;
+					} );
+			}
+		};
+
+	}
+
+	void RunVectorlize( const Options& options ) { Run<Vectorlize>( options, "Vectorlize" ); }
+
+}
@@ -7,17 +7,17 @@ using namespace TestFramework;
 
 TEST_CLASS_BEGIN( ConditionalJudgement )
 
-vector<int> vec = { 0, 13, 40, 12, 50, 12, 60 };
+static const vector<int> vec = { 0, 13, 40, 12, 50, 12, 60 };
 auto linq = Linq::From( vec );
 auto linq2 = linq.Cast<double>().Cast<int>();
 
-vector<int> empty = { };
+static const vector<int> empty = { };
 auto emptyLinq = Linq::From( empty );
 
-vector<int> partical = { 13, 12, 60 };
+static const vector<int> partical = { 13, 12, 60 };
 auto particalLinq = Linq::From( partical );
 
-vector<int> notPartical = { 13, 12, 59 };
+static const vector<int> notPartical = { 13, 12, 59 };
 auto notParticalLinq = Linq::From( notPartical );
 
 TEST_METHOD_BEGIN( All )
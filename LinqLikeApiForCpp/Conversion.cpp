@@ -7,7 +7,7 @@ using namespace TestFramework;
 
 TEST_CLASS_BEGIN( Conversion )
 
-vector<int> vec = { 0, 13, 40, 12, 50, 12, 60 };
+static const vector<int> vec = { 0, 13, 40, 12, 50, 12, 60 };
 auto linq = Linq::From( vec );
 
 TEST_METHOD_BEGIN( Cast )
@@ -22,4 +22,8 @@ TEST_METHOD_BEGIN( Select )
 Assert::IsEqual( vector < int > { 0, 2197, 64000, 1728, 125000, 1728, 216000 }, linq.Select( []( int value ) { return value * value * value; } ).to_vector() );
 TEST_METHOD_END
 
+TEST_METHOD_BEGIN( Select2 )
+Assert::IsEqual( vector<double> { 0, 6.5, 20, 6, 25, 6, 30 }, linq.Select( []( int value ) { return value * 0.5; } ).to_vector() );
+TEST_METHOD_END
+
 TEST_CLASS_END
\ No newline at end of file
@@ -0,0 +1,247 @@
+﻿#include "pch.h"
+#include "TestFramework.h"
+#include "linq.hpp"
+
+using namespace std;
+using namespace TestFramework;
+
+TEST_CLASS_BEGIN( Enumerable )
+
+vector<int> vec = { 0, 13, 40, 12, 50, 12, 60 };
+
+TEST_METHOD_BEGIN( Where )
+auto linq = Linq::AsEnumerable( vec );
+Assert::IsEqual( vector<int> { 0, 40, 12, 50, 12, 60 }, linq.Where( []( int value ) { return value % 2 == 0; } ).to_vector() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Select )
+auto linq = Linq::AsEnumerable( vec );
+Assert::IsEqual( vector<int> { 0, 169, 1600, 144, 2500, 144, 3600 }, linq.Select( []( int value ) { return value * value; } ).to_vector() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Skip )
+auto linq = Linq::AsEnumerable( vec );
+Assert::IsEqual( vector<int> { 40, 12, 50, 12, 60 }, linq.Skip( 2 ).to_vector() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( SkipWhile )
+auto linq = Linq::AsEnumerable( vec );
+Assert::IsEqual( vector<int> { 40, 12, 50, 12, 60 }, linq.SkipWhile( []( int value ) { return value <= 13; } ).to_vector() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Take )
+auto linq = Linq::AsEnumerable( vec );
+Assert::IsEqual( vector<int> { 0, 13, 40 }, linq.Take( 3 ).to_vector() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( TakeWhile )
+auto linq = Linq::AsEnumerable( vec );
+Assert::IsEqual( vector<int> { 0, 13, 40, 12 }, linq.TakeWhile( []( int value ) { return value <= 40; } ).to_vector() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Deferred )
+auto linq = Linq::AsEnumerable( vec );
+size_t calls = 0;
+auto query = linq.Where( [&calls]( int value ) { ++calls; return value % 2 == 0; } ).Select( []( int value ) { return value + 1; } ).Take( 2 );
+Assert::IsEqual( static_cast<size_t>( 0 ), calls );
+Assert::IsEqual( vector<int> { 1, 41 }, query.to_vector() );
+Assert::IsEqual( static_cast<size_t>( 3 ), calls );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Count )
+auto linq = Linq::AsEnumerable( vec );
+Assert::IsEqual( static_cast<size_t>( 3 ), linq.Count( []( int value ) { return value <= 12; } ) );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Sum )
+auto linq = Linq::AsEnumerable( vec );
+Assert::IsEqual( accumulate( cbegin( vec ), cend( vec ), 0 ), linq.Sum() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Average )
+auto linq = Linq::AsEnumerable( vec );
+Assert::IsEqual( accumulate( cbegin( vec ), cend( vec ), 0 ) / static_cast<int>( vec.size() ), linq.Average() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( MinimumMaximum )
+auto linq = Linq::AsEnumerable( vec );
+Assert::IsEqual( 0, linq.Minimum() );
+Assert::IsEqual( 60, linq.Maximum() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( First )
+auto linq = Linq::AsEnumerable( vec );
+Assert::IsEqual( 40, linq.First( []( int value ) { return value > 13; } ) );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Median )
+auto linq = Linq::AsEnumerable( vec );
+Assert::IsEqual( static_cast<int>( 13 ), linq.Median() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Quantile )
+auto linq = Linq::AsEnumerable( vec );
+Assert::IsEqual( 47.5, linq.Where( []( int value ) { return value > 0; } ).Quantile<double>( 0.75 ) );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Stats )
+auto linq = Linq::AsEnumerable( vec );
+const auto stats = linq.Where( []( int value ) { return value >= 12 && value <= 13; } ).Stats();
+Assert::IsEqual( static_cast<size_t>( 3 ), stats.Count() );
+Assert::IsEqual( 12, stats.Minimum() );
+Assert::IsEqual( 13, stats.Maximum() );
+Assert::IsEqual( 37.0, stats.Sum() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( ForEach )
+auto linq = Linq::AsEnumerable( vec );
+vector<int> visited;
+linq.Skip( 1 ).Where( []( int value ) { return value != 40; } ).ForEach( [&visited]( int value ) { visited.push_back( value ); return value != 50; } );
+Assert::IsEqual( vector<int> { 13, 12, 50 }, visited );
+Assert::IsEqual( 72, linq.SkipWhile( []( int value ) { return value < 40; } ).Take( 3 ).Select( []( int value ) { return value - 10; } ).Sum() );
+Assert::IsEqual( static_cast<size_t>( 1 ), linq.TakeWhile( []( int value ) { return value < 40; } ).Count( []( int value ) { return value > 0; } ) );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Fused )
+vector<int> source( 1000 );
+iota( begin( source ), end( source ), 0 );
+int expected = 0;
+for( const auto value : source )
+{
+	if( value % 3 != 0 )
+	{
+		expected += value * 2;
+	}
+}
+auto query = Linq::AsEnumerable( source ).Where( []( int value ) { return value % 3 != 0; } ).Select( []( int value ) { return value * 2; } );
+Assert::IsEqual( expected, query.Sum() );
+Assert::IsEqual( 1996, query.Maximum() );
+Assert::IsTrue( query.All( []( int value ) { return value % 2 == 0; } ) );
+Assert::IsFalse( query.Any( []( int value ) { return value == 6; } ) );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( OrderBy )
+auto linq = Linq::AsEnumerable( vec );
+Assert::IsEqual( vector<int> { 12, 12, 13 }, linq.Where( []( int value ) { return value > 0 && value < 40; } ).OrderBy().to_vector() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( FromStream )
+istringstream stream( "0 13 40 12\n50 12 60" );
+auto linq = Linq::FromStream<int>( stream, 3 );
+Assert::IsEqual( vector<int> { 0, 40, 12, 50, 12, 60 }, linq.Where( []( int value ) { return value % 2 == 0; } ).to_vector() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( FromStream2 )
+istringstream stream( "0 13 40 12 50 12 60" );
+Assert::IsEqual( 187, Linq::FromStream<int>( stream, 2 ).Sum() );
+istringstream stream2( "2.5 0.5 1" );
+Assert::IsEqual( vector<double> { 0.5, 1.0, 2.5 }, Linq::FromStream<double>( stream2 ).OrderBy().to_vector() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( FromStreamMalformed )
+// Trailing whitespace ends the elements, but a token which is not an int throws instead of cutting them short.
+istringstream stream( "1 2 3 \n" );
+Assert::IsEqual( static_cast<size_t>( 3 ), Linq::FromStream<int>( stream ).Count() );
+istringstream malformed( "1 2 x 4" );
+auto thrown = false;
+try
+{
+	Linq::FromStream<int>( malformed ).Sum();
+}
+catch( const runtime_error& )
+{
+	thrown = true;
+}
+Assert::IsTrue( thrown );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( FromLines )
+istringstream stream( "first\n\nthird line\nfourth" );
+Assert::IsEqual(
+	vector<size_t> { 5, 0, 10, 6 },
+	Linq::FromLines( stream, 2 ).Select( []( const string& line ) { return line.size(); } ).to_vector() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Range )
+// Nothing is materialized: a hundred million elements are counted in constant memory.
+Assert::IsEqual( static_cast<size_t>( 33333333 ), Linq::Range( 1, 100000000 ).Count( []( int value ) { return value % 3 == 0; } ) );
+Assert::IsEqual( vector<int> { 2147483645, 2147483646, 2147483647 }, Linq::Range( 2147483645, 2147483647 ).to_vector() );
+Assert::IsTrue( Linq::Range( 1, 0 ).Empty() );
+Assert::IsEqual( vector<char> { 'a', 'b', 'c' }, Linq::Range( 'a', 'c' ).to_vector() );
+auto range = Linq::Range( -2, 2 ).GetEnumerator();
+vector<int> pulled;
+while( range.MoveNext() )
+{
+	pulled.push_back( range.Current() );
+}
+Assert::IsEqual( vector<int> { -2, -1, 0, 1, 2 }, pulled );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Repeat )
+Assert::IsEqual( vector<string> { "ab", "ab", "ab" }, Linq::Repeat( string( "ab" ), 3 ).to_vector() );
+Assert::IsEqual( static_cast<size_t>( 0 ), Linq::Repeat( 1, 0 ).Count() );
+Assert::IsEqual( 7, Linq::Repeat( 7, 5 ).Last() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Generate )
+Assert::IsEqual( vector<int> { 1, 2, 4, 8, 16 }, Linq::Generate( 1, []( int value ) { return value * 2; } ).Take( 5 ).to_vector() );
+Assert::IsEqual( 1023, Linq::Generate( 1, []( int value ) { return value * 2; } ).TakeWhile( []( int value ) { return value < 1000; } ).Sum() );
+int next = 0;
+auto squares = Linq::Generate( [&next]() { ++next; return next * next; } );
+Assert::IsEqual( 49, squares.First( []( int value ) { return value > 40; } ) );
+Assert::IsEqual( 7, next );
+Assert::IsEqual( 64, squares.At( 0 ) );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( ClosedForm )
+// Answered from the bounds without enumerating a billion elements.
+auto range = Linq::Range( 1LL, 1000000000LL );
+Assert::IsEqual( static_cast<size_t>( 1000000000 ), range.Count() );
+Assert::IsEqual( 500000000500000000LL, range.Sum() );
+Assert::IsEqual( 500000000LL, range.Average() );
+Assert::IsEqual( 1LL, range.Minimum() );
+Assert::IsEqual( 1000000000LL, range.Maximum() );
+Assert::IsEqual( 1000000000LL, range.Last() );
+Assert::IsEqual( 1000LL, range.At( 999 ) );
+Assert::IsTrue( range.Contain( 999999999LL ) );
+Assert::IsFalse( range.Contain( 0LL ) );
+Assert::IsEqual( vector<long long> { 999999991LL, 999999992LL, 999999993LL }, range.Skip( 999999990 ).Take( 3 ).to_vector() );
+Assert::IsTrue( is_same<decltype( range ), decltype( range.Skip( 1 ).Take( 1 ) )>::value );
+Assert::IsTrue( range.Skip( 2000000000 ).Empty() );
+Assert::IsEqual( Linq::Range( -5, 4 ).ToVectorable().Median(), Linq::Range( -5, 4 ).Median() );
+Assert::IsEqual( 0, Linq::Range( -5, 5 ).Median() );
+auto thrown = false;
+try
+{
+	Linq::Range( 10, 20 ).At( 11 );
+}
+catch( const out_of_range& )
+{
+	thrown = true;
+}
+Assert::IsTrue( thrown );
+
+auto repeat = Linq::Repeat( 3LL, 1000000000 );
+Assert::IsEqual( 3000000000LL, repeat.Sum() );
+Assert::IsEqual( 3LL, repeat.Median() );
+Assert::IsEqual( static_cast<size_t>( 2 ), repeat.Skip( 999999998 ).Count() );
+Assert::IsEqual( 2.5, Linq::Repeat( 2.5, 4 ).Average() );
+Assert::IsFalse( Linq::Repeat( 7, 0 ).Contain( 7 ) );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( AverageOverflow )
+// The sums exceed INT_MAX; the averages are added up in long double, and the closed form takes the midpoint.
+const auto all = []( int ) { return true; };
+Assert::IsEqual( 50000, Linq::Range( 1, 100000 ).Where( all ).Average() );
+Assert::IsEqual( 50000, Linq::Range( 1, 100000 ).Average() );
+Assert::IsEqual( 2147483623, Linq::Range( 2147483600, 2147483647 ).Where( all ).Average() );
+Assert::IsEqual( 2147483623, Linq::Range( 2147483600, 2147483647 ).Average() );
+Assert::IsEqual( 1000000, Linq::Repeat( 1000000, 10000 ).Where( all ).Average() );
+Assert::IsEqual( 1000000, Linq::Repeat( 1000000, 10000 ).Average() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( FromVectorable )
+Assert::IsEqual( vector<int> { 60, 12 }, Linq::From( vec ).Reverse().AsEnumerable().Take( 2 ).to_vector() );
+TEST_METHOD_END
+
+TEST_CLASS_END
\ No newline at end of file
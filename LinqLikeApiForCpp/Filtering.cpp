@@ -7,7 +7,7 @@ using namespace TestFramework;
 
 TEST_CLASS_BEGIN( Filtering )
 
-vector<int> vec = { 0, 13, 40, 12, 50, 12, 60 };
+static const vector<int> vec = { 0, 13, 40, 12, 50, 12, 60 };
 auto linq = Linq::From( vec );
 
 TEST_METHOD_BEGIN( Where )
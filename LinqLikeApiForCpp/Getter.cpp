@@ -7,7 +7,7 @@ using namespace TestFramework;
 
 TEST_CLASS_BEGIN( Getter )
 
-vector<int> vec = { 0, 13, 40, 12, 50, 12, 60 };
+static const vector<int> vec = { 0, 13, 40, 12, 50, 12, 60 };
 auto linq = Linq::From( vec );
 
 TEST_METHOD_BEGIN( First )
@@ -30,4 +30,15 @@ TEST_METHOD_BEGIN( Last2 )
 Assert::IsEqual( *vec.cbegin(), linq.Last( []( int value ) { return value < 12; } ) );
 TEST_METHOD_END
 
+TEST_METHOD_BEGIN( Borrowed )
+Assert::IsTrue( linq.IsBorrowed() );
+Assert::IsTrue( vec.data() == linq.CBegin() );
+Assert::IsFalse( linq.Skip( 1 ).IsBorrowed() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Borrowed2 )
+Assert::IsFalse( Linq::From( vector<int> { 1, 2, 3 } ).IsBorrowed() );
+Assert::IsEqual( 6, Linq::From( vector<int> { 1, 2, 3 } ).Sum() );
+TEST_METHOD_END
+
 TEST_CLASS_END
\ No newline at end of file
@@ -0,0 +1,47 @@
+#include "pch.h"
+#include "TestFramework.h"
+#include "linq.hpp"
+
+using namespace std;
+using namespace TestFramework;
+
+TEST_CLASS_BEGIN( Grouping )
+
+static const vector<int> vec = { 0, 13, 40, 12, 50, 12, 60 };
+auto linq = Linq::From( vec );
+
+TEST_METHOD_BEGIN( ToLookup )
+auto lookup = linq.ToLookup( []( int value ) { return value % 10; } );
+Assert::IsEqual( static_cast<size_t>( 3 ), lookup.Count() );
+Assert::IsEqual( vector<int> { 0, 3, 2 }, Linq::Range( static_cast<size_t>( 0 ), lookup.Count() - 1 ).Select( [&lookup]( size_t index ) { return lookup.KeyAt( index ); } ).to_vector() );
+Assert::IsEqual( vector<int> { 0, 40, 50, 60 }, lookup.At( 0 ).to_vector() );
+Assert::IsEqual( vector<int> { 12, 12 }, lookup[2].to_vector() );
+Assert::IsTrue( lookup.Contain( 3 ) );
+Assert::IsFalse( lookup.Contain( 7 ) );
+Assert::IsTrue( lookup[7].Empty() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( ToLookup2 )
+auto lookup = linq.ToLookup( []( int value ) { return value >= 40; }, []( int value ) { return value / 10; } );
+Assert::IsEqual( vector<int> { 0, 1, 1, 1 }, lookup[false].to_vector() );
+Assert::IsEqual( vector<int> { 4, 5, 6 }, lookup[true].to_vector() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Select )
+auto lookup = linq.ToLookup( []( int value ) { return value % 10; } );
+Assert::IsEqual( vector<int> { 150, 13, 24 }, lookup.Select( []( int, const Linq::Vectorable<int>& group ) { return group.Sum(); } ).to_vector() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Aggregate )
+auto sums = linq.GroupBy( []( int value ) { return value % 10; } ).Aggregate( 0, plus<int>() );
+Assert::IsEqual( vector<int> { 0, 3, 2 }, sums.Select( []( const pair<int, int>& p ) { return p.first; } ).to_vector() );
+Assert::IsEqual( vector<int> { 150, 13, 24 }, sums.Select( []( const pair<int, int>& p ) { return p.second; } ).to_vector() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Count )
+auto counts = Linq::Range( 0, 99999 ).GroupBy( []( int value ) { return value % 1000; } ).Count();
+Assert::IsEqual( static_cast<size_t>( 1000 ), counts.Count() );
+Assert::IsTrue( counts.All( []( const pair<int, size_t>& p ) { return p.second == 100; } ) );
+TEST_METHOD_END
+
+TEST_CLASS_END
\ No newline at end of file
@@ -0,0 +1,96 @@
+﻿#include "pch.h"
+#include "TestFramework.h"
+#include "linq.hpp"
+
+#include <sstream>
+
+using namespace std;
+using namespace TestFramework;
+
+TEST_CLASS_BEGIN( Instrumentation )
+
+#ifdef LINQ_ENABLE_INSTRUMENTATION
+
+static const vector<int> vec = { 0, 13, 40, 12, 50, 12, 60 };
+auto linq = Linq::From( vec );
+
+TEST_METHOD_BEGIN( Stats )
+Linq::Instrumentation::Reset();
+linq.Where( []( int value ) { return value % 2 == 0; } );
+const auto stats = Linq::Instrumentation::Stats();
+Assert::IsEqual( static_cast<size_t>( 1 ), stats.size() );
+Assert::IsEqual( string( "Where" ), stats[0].name );
+Assert::IsEqual( static_cast<uint64_t>( 1 ), stats[0].calls );
+Assert::IsEqual( static_cast<uint64_t>( 7 ), stats[0].elementsIn );
+Assert::IsEqual( static_cast<uint64_t>( 6 ), stats[0].elementsOut );
+Assert::IsEqual( static_cast<uint64_t>( 7 ), stats[0].invocations );
+Assert::IsEqual( static_cast<uint64_t>( 7 * sizeof( int ) ), stats[0].bytesAllocated );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( InPlace )
+Linq::Instrumentation::Reset();
+const auto selected = linq.Where( []( int value ) { return value > 12; } ).Select( []( int value ) { return value + 1; } ).Reverse().to_vector();
+Assert::IsEqual( vector<int> { 61, 51, 41, 14 }, selected );
+const auto events = Linq::Instrumentation::Events();
+Assert::IsEqual( static_cast<size_t>( 3 ), events.size() );
+Assert::IsEqual( string( "Select" ), string( events[1].name ) );
+Assert::IsEqual( static_cast<uint64_t>( 4 ), events[1].invocations );
+Assert::IsEqual( static_cast<uint64_t>( 0 ), events[1].bytesAllocated );
+Assert::IsEqual( string( "Reverse" ), string( events[2].name ) );
+Assert::IsEqual( static_cast<uint64_t>( 0 ), events[2].bytesAllocated );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Nested )
+Linq::Instrumentation::Reset();
+Assert::IsEqual( vector<int> { 0, 12, 13, 40 }, linq.Except( Linq::From( vector<int> { 12, 50, 60 } ), less<int>() ).to_vector() );
+const auto events = Linq::Instrumentation::Events();
+Assert::IsEqual( static_cast<size_t>( 3 ), events.size() );
+Assert::IsEqual( string( "OrderBy" ), string( events[0].name ) );
+Assert::IsEqual( string( "OrderBy" ), string( events[1].name ) );
+Assert::IsEqual( string( "Except" ), string( events[2].name ) );
+Assert::IsEqual( static_cast<uint64_t>( 10 ), events[2].elementsIn );
+Assert::IsTrue( events[2].start <= events[0].start && events[0].start + events[0].duration <= events[2].start + events[2].duration );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( ChromeTrace )
+Linq::Instrumentation::Reset();
+linq.OrderByDescending().Distinct();
+ostringstream stream;
+Linq::Instrumentation::WriteChromeTrace( stream );
+const auto trace = stream.str();
+Assert::IsTrue( trace.find( "\"traceEvents\":[" ) == 1 );
+Assert::IsTrue( trace.find( "\"name\":\"OrderBy\",\"cat\":\"linq\",\"ph\":\"X\"" ) != string::npos );
+Assert::IsTrue( trace.find( "\"name\":\"Distinct\"" ) != string::npos );
+Assert::IsTrue( trace.find( "\"elementsOut\":6" ) != string::npos );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Enumerable )
+// One event for the fused loop of the terminal, whose elements in are the ones that pass Where.
+Linq::Instrumentation::Reset();
+Assert::IsEqual( 167, Linq::AsEnumerable( vec ).Where( []( int value ) { return value > 12; } ).Select( []( int value ) { return value + 1; } ).Sum() );
+const auto events = Linq::Instrumentation::Events();
+Assert::IsEqual( static_cast<size_t>( 1 ), events.size() );
+Assert::IsEqual( string( "Sum" ), string( events[0].name ) );
+Assert::IsEqual( static_cast<uint64_t>( 4 ), events[0].elementsIn );
+Assert::IsEqual( static_cast<uint64_t>( 1 ), events[0].elementsOut );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Parallel )
+Linq::Instrumentation::Reset();
+const auto parallel = linq.AsParallel().WithSequentialThreshold( 0 ).WithDegreeOfParallelism( 3 );
+Assert::IsEqual( 187, parallel.Sum() );
+Assert::IsEqual( static_cast<size_t>( 3 ), parallel.Where( []( int value ) { return value > 13; } ).Count() );
+Assert::IsEqual( static_cast<size_t>( 2 ), parallel.Count( 12 ) );
+const auto stats = Linq::Instrumentation::Stats();
+Assert::IsEqual( static_cast<size_t>( 3 ), stats.size() );
+Assert::IsEqual( string( "Sum" ), stats[0].name );
+Assert::IsEqual( static_cast<uint64_t>( 7 ), stats[0].elementsIn );
+Assert::IsEqual( string( "Where" ), stats[1].name );
+Assert::IsEqual( static_cast<uint64_t>( 3 ), stats[1].elementsOut );
+Assert::IsEqual( static_cast<uint64_t>( 3 * sizeof( int ) ), stats[1].bytesAllocated );
+Assert::IsEqual( string( "Count" ), stats[2].name );
+TEST_METHOD_END
+
+#endif
+
+TEST_CLASS_END
\ No newline at end of file
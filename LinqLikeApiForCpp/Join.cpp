@@ -0,0 +1,49 @@
+#include "pch.h"
+#include "TestFramework.h"
+#include "linq.hpp"
+
+using namespace std;
+using namespace TestFramework;
+
+TEST_CLASS_BEGIN( Join )
+
+static const vector<int> vec = { 0, 13, 40, 12, 50, 12, 60 };
+static const vector<int> vec2 = { 112, 160, 7, 207, 0, 260 };
+auto linq = Linq::From( vec );
+auto inner = Linq::From( vec2 );
+
+TEST_METHOD_BEGIN( Join )
+Assert::IsEqual(
+	vector<int> { 0, 112, 112, 160, 260 },
+	linq.Join( inner, []( int value ) { return value; }, []( int value ) { return value % 100; }, []( int, int value ) { return value; } ).to_vector() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Join2 )
+// The outer side is the smaller one here, so the hash table is built on it.
+Assert::IsEqual(
+	vector<int> { 6160, 6260, 1312 },
+	Linq::From( vector<int> { 60, 12, 99 } ).Join( inner, []( int value ) { return value; }, []( int value ) { return value % 100; }, []( int x, int y ) { return x * 100 + y; } ).to_vector() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Join3 )
+auto joined = Linq::Range( 1, 100000 ).ToVectorable().Join( Linq::Range( 1, 1000 ).ToVectorable(), []( int value ) { return value % 1000; }, []( int value ) { return value % 1000; }, []( int x, int y ) { return x - y; } );
+Assert::IsEqual( static_cast<size_t>( 100000 ), joined.Count() );
+Assert::IsTrue( joined.All( []( int value ) { return value % 1000 == 0; } ) );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( GroupJoin )
+Assert::IsEqual(
+	vector<size_t> { 1, 0, 0, 1, 0, 1, 2 },
+	linq.GroupJoin( inner, []( int value ) { return value; }, []( int value ) { return value % 100; }, []( int, const Linq::Vectorable<int>& group ) { return group.Count(); } ).to_vector() );
+Assert::IsEqual(
+	vector<int> { 0, 0, 0, 112, 0, 112, 420 },
+	linq.GroupJoin( inner, []( int value ) { return value; }, []( int value ) { return value % 100; }, []( int, const Linq::Vectorable<int>& group ) { return group.Sum(); } ).to_vector() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( MergeJoin )
+Assert::IsEqual(
+	vector<int> { 0, 112, 112, 160, 260 },
+	linq.OrderBy().MergeJoin( Linq::From( vector<int> { 0, 112, 160, 260 } ), []( int value ) { return value; }, []( int value ) { return value % 100; }, []( int, int value ) { return value; } ).to_vector() );
+TEST_METHOD_END
+
+TEST_CLASS_END
\ No newline at end of file
@@ -9,6 +9,17 @@ DEFINE_TEST_CLASS( BasicCalc )
 DEFINE_TEST_CLASS( Filtering )
 DEFINE_TEST_CLASS( BasicOperation )
 DEFINE_TEST_CLASS( Conversion )
+DEFINE_TEST_CLASS( Enumerable )
+DEFINE_TEST_CLASS( Parallel )
+DEFINE_TEST_CLASS( SetCalc )
+DEFINE_TEST_CLASS( Grouping )
+DEFINE_TEST_CLASS( Join )
+DEFINE_TEST_CLASS( MappedFile )
+DEFINE_TEST_CLASS( Allocator )
+DEFINE_TEST_CLASS( Instrumentation )
+DEFINE_TEST_CLASS( Windowing )
+DEFINE_TEST_CLASS( AsyncEnumerable )
+DEFINE_TEST_CLASS( Observable )
 
 #ifdef __cplusplus_winrt
 int main( ::Platform::Array<::Platform::String^>^ /*args*/ )
@@ -22,6 +33,17 @@ int main( int /*argc*/, char* /*args*/[] )
 	REGISTER_TEST_CLASS( Filtering )
 	REGISTER_TEST_CLASS( BasicOperation )
 	REGISTER_TEST_CLASS( Conversion )
+	REGISTER_TEST_CLASS( Enumerable )
+	REGISTER_TEST_CLASS( Parallel )
+	REGISTER_TEST_CLASS( SetCalc )
+	REGISTER_TEST_CLASS( Grouping )
+	REGISTER_TEST_CLASS( Join )
+	REGISTER_TEST_CLASS( MappedFile )
+	REGISTER_TEST_CLASS( Allocator )
+	REGISTER_TEST_CLASS( Instrumentation )
+	REGISTER_TEST_CLASS( Windowing )
+	REGISTER_TEST_CLASS( AsyncEnumerable )
+	REGISTER_TEST_CLASS( Observable )
 
 	TestFramework::Run();
 	TestFramework::Wait();
@@ -0,0 +1,60 @@
+#include "pch.h"
+#include "TestFramework.h"
+#include "linq.hpp"
+
+#include <cstdio>
+#include <fstream>
+
+using namespace std;
+using namespace TestFramework;
+
+TEST_CLASS_BEGIN( MappedFile )
+
+#ifdef LINQ_HAS_MAPPED_FILE
+
+static const vector<int> vec = { 0, 13, 40, 12, 50, 12, 60 };
+auto linq = Linq::From( vec );
+
+TEST_METHOD_BEGIN( FromMappedFile )
+{
+	ofstream file( "linq_mapped.bin", ios::binary );
+	file.write( reinterpret_cast<const char*>( vec.data() ), vec.size() * sizeof( int ) );
+}
+{
+	auto mapped = Linq::FromMappedFile<int>( "linq_mapped.bin" );
+	Assert::IsTrue( mapped.IsBorrowed() );
+	Assert::IsEqual( vec, mapped.to_vector() );
+	Assert::IsEqual( 187, mapped.Sum() );
+	Assert::IsEqual( vector<int> { 12, 12, 13 }, mapped.Where( []( int value ) { return value > 0 && value < 40; } ).OrderBy().to_vector() );
+}
+remove( "linq_mapped.bin" );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Snapshot )
+linq.Where( []( int value ) { return value % 2 == 0; } ).to_file( "linq_snapshot.bin" );
+{
+	auto snapshot = Linq::FromSnapshot<int>( "linq_snapshot.bin", true );
+	Assert::IsEqual( vector<int> { 0, 40, 12, 50, 12, 60 }, snapshot.to_vector() );
+	Assert::IsEqual( 60, snapshot.AsEnumerable().Maximum() );
+}
+{
+	fstream file( "linq_snapshot.bin", ios::binary | ios::in | ios::out );
+	file.seekp( -1, ios::end );
+	file.put( 1 );
+}
+auto corrupted = false;
+try
+{
+	Linq::FromSnapshot<int>( "linq_snapshot.bin", true );
+}
+catch( const runtime_error& )
+{
+	corrupted = true;
+}
+Assert::IsTrue( corrupted );
+remove( "linq_snapshot.bin" );
+TEST_METHOD_END
+
+#endif
+
+TEST_CLASS_END
\ No newline at end of file
@@ -0,0 +1,229 @@
+﻿#include "pch.h"
+#include "TestFramework.h"
+#include "linq.hpp"
+
+using namespace std;
+using namespace TestFramework;
+
+TEST_CLASS_BEGIN( Observable )
+
+static const vector<int> vec = { 0, 13, 40, 12, 50, 12, 60 };
+
+TEST_METHOD_BEGIN( Aggregates )
+Linq::Observable<int> source;
+const auto even = source.Where( []( int value ) { return value % 2 == 0; } );
+const auto count = even.Count();
+const auto sum = even.Sum();
+const auto minimum = source.Minimum();
+const auto maximum = source.Maximum();
+Assert::IsTrue( count.Empty() );
+Assert::IsEqual( 0, sum.Value() );
+for( const auto value : vec )
+{
+	source.OnNext( value );
+}
+Assert::IsEqual( static_cast<size_t>( 6 ), count.Value() );
+Assert::IsEqual( 174, sum.Value() );
+Assert::IsEqual( 0, minimum.Value() );
+Assert::IsEqual( 60, maximum.Value() );
+Assert::IsEqual( static_cast<size_t>( 7 ), maximum.Count() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Incremental )
+Linq::Observable<int> source;
+const auto sum = source.Select( []( int value ) { return value * 2; } ).Sum();
+const auto average = source.Select<double>( []( int value ) { return value; } ).Average();
+vector<int> sums;
+for( const auto value : vec )
+{
+	source.OnNext( value );
+	sums.push_back( sum.Value() );
+}
+Assert::IsEqual( vector<int> { 0, 26, 106, 130, 230, 254, 374 }, sums );
+Assert::IsEqual( 187.0 / 7.0, average.Value() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Window )
+Linq::Observable<int> source;
+const auto window = source.Window( 3 );
+const auto sum = window.Sum();
+const auto count = window.Where( []( int value ) { return value > 12; } ).Count();
+const auto minimum = window.Minimum();
+const auto maximum = window.Maximum();
+vector<int> sums, minimums, maximums;
+vector<size_t> counts;
+for( const auto value : vec )
+{
+	source.OnNext( value );
+	sums.push_back( sum.Value() );
+	counts.push_back( count.Value() );
+	minimums.push_back( minimum.Value() );
+	maximums.push_back( maximum.Value() );
+}
+Assert::IsEqual( vector<int> { 0, 13, 53, 65, 102, 74, 122 }, sums );
+Assert::IsEqual( vector<size_t> { 0, 1, 2, 2, 2, 1, 2 }, counts );
+Assert::IsEqual( vector<int> { 0, 0, 0, 12, 12, 12, 12 }, minimums );
+Assert::IsEqual( vector<int> { 0, 13, 40, 40, 50, 50, 60 }, maximums );
+Assert::IsEqual( static_cast<size_t>( 3 ), sum.Count() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Distinct )
+Linq::Observable<int> source;
+const auto all = source.Distinct().Count();
+const auto window = source.Window( 2 ).Distinct();
+const auto count = window.Count();
+const auto sum = window.Sum();
+vector<size_t> counts;
+vector<int> sums;
+for( const auto value : { 1, 1, 2, 2, 2, 1, 3 } )
+{
+	source.OnNext( value );
+	counts.push_back( count.Value() );
+	sums.push_back( sum.Value() );
+}
+Assert::IsEqual( static_cast<size_t>( 3 ), all.Value() );
+Assert::IsEqual( vector<size_t> { 1, 1, 2, 1, 1, 2, 2 }, counts );
+Assert::IsEqual( vector<int> { 1, 1, 3, 2, 2, 3, 4 }, sums );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( DistinctExtremes )
+// Distinct expires 2 while the older 1 is still in the window.
+Linq::Observable<int> source;
+const auto distinct = source.Window( 3 ).Distinct();
+const auto minimum = distinct.Minimum();
+const auto maximum = distinct.Maximum();
+vector<int> minimums, maximums;
+for( const auto value : { 1, 2, 1, 3, 4, 5 } )
+{
+	source.OnNext( value );
+	minimums.push_back( minimum.Value() );
+	maximums.push_back( maximum.Value() );
+}
+Assert::IsEqual( vector<int> { 1, 1, 1, 1, 1, 3 }, minimums );
+Assert::IsEqual( vector<int> { 1, 2, 2, 3, 4, 5 }, maximums );
+Assert::IsEqual( static_cast<size_t>( 3 ), minimum.Count() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Stateful )
+// The predicate lets every other value through and the selector counts its calls, so calling them again on expiry would show.
+Linq::Observable<int> source;
+const auto window = source.Window( 3 );
+auto calls = make_shared<int>( 0 );
+const auto admitted = window.Where( [calls]( int ) { return ( *calls )++ % 2 == 0; } ).Sum();
+auto selected = make_shared<int>( 0 );
+const auto distinct = window.Distinct().Select( [selected]( int value ) { ++*selected; return value * 10; } ).Sum();
+vector<int> admittedSums, distinctSums;
+for( const auto value : { 1, 2, 1, 3, 1, 4, 4, 5 } )
+{
+	source.OnNext( value );
+	admittedSums.push_back( admitted.Value() );
+	distinctSums.push_back( distinct.Value() );
+}
+Assert::IsEqual( vector<int> { 1, 1, 2, 1, 2, 1, 5, 4 }, admittedSums );
+Assert::IsEqual( vector<int> { 10, 30, 30, 60, 40, 80, 50, 90 }, distinctSums );
+Assert::IsEqual( 8, *calls );
+Assert::IsEqual( 5, *selected );
+TEST_METHOD_END
+
+// Counts the live copies, to see what the stages keep.
+static int live = 0;
+struct Tracked
+{
+	int value;
+	Tracked( int value ) : value( value ) { ++live; }
+	Tracked( const Tracked& other ) : value( other.value ) { ++live; }
+	~Tracked() { --live; }
+	bool operator==( const Tracked& other ) const { return value == other.value; }
+};
+
+TEST_METHOD_BEGIN( DistinctFootprint )
+{
+	Linq::Observable<Tracked> source;
+	const auto count = source.Window( 4 ).Distinct( []( const Tracked& value ) { return hash<int>()( value.value ); }, equal_to<Tracked>() ).Count();
+	for( auto i = 0; i < 10000; ++i )
+	{
+		source.OnNext( Tracked( i / 2 ) );
+		Assert::IsTrue( live <= 8 );
+	}
+	Assert::IsEqual( static_cast<size_t>( 2 ), count.Value() );
+}
+Assert::IsEqual( 0, live );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Long )
+// Compared with running the query again on the buffer after every value.
+Linq::Observable<int> source;
+const auto window = source.Where( []( int value ) { return value % 5 != 0; } ).Window( 50 ).Window( 40 );
+const auto sum = window.Sum();
+const auto minimum = window.Minimum();
+const auto maximum = window.Select( []( int value ) { return value % 100; } ).Maximum();
+vector<int> buffer;
+unsigned int state = 12345;
+for( auto i = 0; i < 3000; ++i )
+{
+	state = state * 1103515245u + 12345u;
+	const auto value = static_cast<int>( ( state >> 16 ) % 1000 );
+	source.OnNext( value );
+	if( value % 5 != 0 )
+	{
+		buffer.push_back( value );
+	}
+	if( buffer.empty() )
+	{
+		continue;
+	}
+	const auto last = Linq::From( buffer ).Skip( buffer.size() - min( buffer.size(), static_cast<size_t>( 40 ) ) );
+	Assert::IsEqual( last.Sum(), sum.Value() );
+	Assert::IsEqual( last.Minimum(), minimum.Value() );
+	Assert::IsEqual( last.Select( []( int value ) { return value % 100; } ).Maximum(), maximum.Value() );
+}
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Compensated )
+Linq::Observable<double> source;
+const auto window = source.Window( 3 );
+const auto sum = window.Sum();
+const auto average = window.Average();
+vector<double> sums;
+for( const auto value : { 1e16, 1.0, 1.0, 1.0, 0.5 } )
+{
+	source.OnNext( value );
+	sums.push_back( sum.Value() );
+}
+Assert::IsEqual( vector<double> { 1e16, 1e16, 1e16 + 2.0, 3.0, 2.5 }, sums );
+Assert::IsEqual( 2.5 / 3.0, average.Value() );
+
+// Mixed magnitudes, compared with summing the window again whenever no large value is in it.
+Linq::Observable<double> mixed;
+const auto mixedSum = mixed.Window( 50 ).Sum();
+vector<double> buffer;
+unsigned int state = 12345;
+for( auto i = 0; i < 20000; ++i )
+{
+	state = state * 1103515245u + 12345u;
+	const auto value = i % 97 == 0 ? 1e15 : static_cast<double>( ( state >> 16 ) % 1000 ) * 0.1;
+	mixed.OnNext( value );
+	buffer.push_back( value );
+	if( i % 97 < 50 )
+	{
+		continue;
+	}
+	const auto expected = accumulate( buffer.end() - 50, buffer.end(), 0.0L );
+	Assert::IsTrue( abs( static_cast<long double>( mixedSum.Value() ) - expected ) < 1e-9L );
+}
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Errors )
+Linq::Observable<double> source;
+auto thrown = 0;
+try { source.Window( 0 ); } catch( const out_of_range& ) { ++thrown; }
+try { source.Minimum().Value(); } catch( const out_of_range& ) { ++thrown; }
+try { source.Average().Value(); } catch( const out_of_range& ) { ++thrown; }
+Assert::IsEqual( 3, thrown );
+const auto maximum = source.Window( 1 ).Maximum();
+source.OnNext( 2.5 );
+source.OnNext( 1.5 );
+Assert::IsEqual( 1.5, maximum.Value() );
+TEST_METHOD_END
+
+TEST_CLASS_END
\ No newline at end of file
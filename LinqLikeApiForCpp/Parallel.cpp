@@ -0,0 +1,66 @@
+#include "pch.h"
+#include "TestFramework.h"
+#include "linq.hpp"
+
+using namespace std;
+using namespace TestFramework;
+
+TEST_CLASS_BEGIN( Parallel )
+
+static const vector<int> vec = { 0, 13, 40, 12, 50, 12, 60 };
+auto linq = Linq::From( vec ).AsParallel().WithSequentialThreshold( 0 ).WithDegreeOfParallelism( 3 );
+
+static const auto large = Linq::Range( 1, 200000 ).to_vector();
+auto largeLinq = Linq::From( large ).AsParallel();
+
+TEST_METHOD_BEGIN( Where )
+Assert::IsEqual( vector<int> { 0, 40, 12, 50, 12, 60 }, linq.Where( []( int value ) { return value % 2 == 0; } ).to_vector() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Where2 )
+Assert::IsEqual(
+	Linq::From( large ).Where( []( int value ) { return value % 7 == 3; } ).to_vector(),
+	largeLinq.Where( []( int value ) { return value % 7 == 3; } ).to_vector() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Select )
+Assert::IsEqual( vector<int> { 0, 169, 1600, 144, 2500, 144, 3600 }, linq.Select( []( int value ) { return value * value; } ).to_vector() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Select2 )
+Assert::IsEqual(
+	Linq::From( large ).Select( []( int value ) { return value * 0.5; } ).to_vector(),
+	largeLinq.Select( []( int value ) { return value * 0.5; } ).to_vector() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Count )
+Assert::IsEqual( static_cast<size_t>( 3 ), linq.Count( []( int value ) { return value <= 12; } ) );
+Assert::IsEqual( static_cast<size_t>( 28571 ), largeLinq.Count( []( int value ) { return value % 7 == 0; } ) );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Sum )
+Assert::IsEqual( 187, linq.Sum() );
+Assert::IsEqual( 20000100000LL, largeLinq.Select( []( int value ) { return static_cast<long long>( value ); } ).Sum() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Stats )
+const auto stats = largeLinq.Stats();
+Assert::IsEqual( static_cast<size_t>( 200000 ), stats.Count() );
+Assert::IsEqual( 20000100000.0, stats.Sum() );
+Assert::IsEqual( 100000.5, stats.Mean() );
+Assert::IsEqual( 1, stats.Minimum() );
+Assert::IsEqual( 200000, stats.Maximum() );
+Assert::IsTrue( abs( stats.Variance() - ( 200000.0 * 200000.0 - 1.0 ) / 12.0 ) < 1e-3 );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Aggregate )
+Assert::IsEqual( 60, linq.Aggregate( 0, []( int x, int y ) { return max( x, y ); } ) );
+Assert::IsEqual( static_cast<size_t>( 200000 ), largeLinq.Aggregate( static_cast<size_t>( 0 ), []( size_t x, int ) { return x + 1; }, plus<size_t>() ) );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Sequential )
+Assert::IsEqual( 187, linq.WithDegreeOfParallelism( 1 ).Sum() );
+Assert::IsEqual( 187, Linq::From( vec ).AsParallel().Sum() );
+TEST_METHOD_END
+
+TEST_CLASS_END
\ No newline at end of file
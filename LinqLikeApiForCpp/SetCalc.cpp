@@ -0,0 +1,76 @@
+#include "pch.h"
+#include "TestFramework.h"
+#include "linq.hpp"
+
+using namespace std;
+using namespace TestFramework;
+
+TEST_CLASS_BEGIN( SetCalc )
+
+static const vector<int> vec = { 0, 13, 40, 12, 50, 12, 60 };
+static const vector<int> vec2 = { 12, 60, 7, 7, 0 };
+auto linq = Linq::From( vec );
+auto second = Linq::From( vec2 );
+
+TEST_METHOD_BEGIN( Distinct )
+Assert::IsEqual( vector<int> { 0, 13, 40, 12, 50, 60 }, linq.Distinct().to_vector() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Distinct2 )
+Assert::IsEqual(
+	vector<int> { 0, 13, 12 },
+	linq.Distinct( []( int value ) { return hash<int>()( value % 10 ); }, []( int x, int y ) { return x % 10 == y % 10; } ).to_vector() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Distinct3 )
+auto expected = Linq::Range( 0, 4999 ).to_vector();
+Assert::IsEqual( expected, Linq::Range( 0, 99999 ).Select( []( int value ) { return value % 5000; } ).Distinct().to_vector() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Except )
+Assert::IsEqual( vector<int> { 13, 40, 50 }, linq.Except( second ).to_vector() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Except2 )
+Assert::IsEqual( vector<int> { 12, 13, 40, 50 }, linq.Except( second, less<int>() ).to_vector() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Union )
+Assert::IsEqual( vector<int> { 0, 13, 40, 12, 50, 60, 7 }, linq.Union( second ).to_vector() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Intersect )
+Assert::IsEqual( vector<int> { 0, 12, 60 }, linq.Intersect( second ).to_vector() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Intersect2 )
+Assert::IsEqual( vector<int> { 0, 12, 60 }, linq.Intersect( second, less<int>() ).to_vector() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( SymmetricDiffer )
+Assert::IsEqual( vector<int> { 13, 40, 50, 7 }, linq.SymmetricDiffer( second ).to_vector() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Concat )
+Assert::IsEqual( vector<int> { 0, 13, 40, 12, 50, 12, 60, 12, 60, 7, 7, 0 }, linq.Concat( second ).to_vector() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Sorted )
+// Sorted inputs are merged without a hash set, and with the same results.
+auto sorted = linq.OrderBy();
+auto sortedSecond = second.OrderBy();
+Assert::IsEqual( linq.Except( second ).OrderBy().to_vector(), sorted.Except( sortedSecond ).to_vector() );
+Assert::IsEqual( linq.Intersect( second ).OrderBy().to_vector(), sorted.Intersect( sortedSecond ).to_vector() );
+Assert::IsEqual( linq.Intersect( second ).OrderByDescending().to_vector(), linq.OrderByDescending().Intersect( second.OrderByDescending() ).to_vector() );
+Assert::IsEqual( vector<int> { 0, 12, 13, 40, 50, 60 }, sorted.Distinct().to_vector() );
+Assert::IsEqual( vector<int> { 12, 13, 40, 50 }, sorted.Except( sortedSecond, less<int>() ).Distinct().to_vector() );
+Assert::IsTrue( Linq::Ordering::Ascending == sorted.Union( sortedSecond, less<int>() ).GetOrdering() );
+auto large = Linq::Range( 0, 99999 ).ToVectorable().OrderBy();
+auto few = Linq::From( vector<int> { -5, 7, 7, 99999, 100000 } ).OrderBy();
+Assert::IsEqual( vector<int> { 7, 99999 }, large.Intersect( few ).to_vector() );
+Assert::IsEqual( vector<int> { 7, 99999 }, few.Intersect( large ).to_vector() );
+Assert::IsEqual( vector<int> { -5, 100000 }, few.Except( large ).to_vector() );
+Assert::IsEqual( static_cast<size_t>( 99998 ), large.Except( few ).Count() );
+TEST_METHOD_END
+
+TEST_CLASS_END
\ No newline at end of file
@@ -0,0 +1,108 @@
+﻿#include "pch.h"
+#include "TestFramework.h"
+#include "linq.hpp"
+
+using namespace std;
+using namespace TestFramework;
+
+TEST_CLASS_BEGIN( Windowing )
+
+static const vector<int> vec = { 0, 13, 40, 12, 50, 12, 60 };
+auto linq = Linq::From( vec );
+
+TEST_METHOD_BEGIN( Chunk )
+const auto chunks = linq.Chunk( 3 );
+Assert::IsEqual( static_cast<size_t>( 3 ), chunks.Count() );
+Assert::IsEqual( vector<int> { 0, 13, 40 }, chunks.At( 0 ).to_vector() );
+Assert::IsEqual( vector<int> { 12, 50, 12 }, chunks.At( 1 ).to_vector() );
+Assert::IsEqual( vector<int> { 60 }, chunks.At( 2 ).to_vector() );
+Assert::IsEqual( vector<int> { 53, 74, 60 }, chunks.Select( []( const Linq::Vectorable<int>& chunk ) { return chunk.Sum(); } ).to_vector() );
+Assert::IsTrue( Linq::From( vector<int>() ).Chunk( 2 ).Empty() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Window )
+const auto windows = linq.Window( 3, 2 );
+Assert::IsEqual( static_cast<size_t>( 3 ), windows.Count() );
+Assert::IsEqual( vector<int> { 0, 13, 40 }, windows.First().to_vector() );
+Assert::IsEqual( vector<int> { 50, 12, 60 }, windows.Last().to_vector() );
+Assert::IsEqual( static_cast<size_t>( 5 ), linq.Window( 3 ).Count() );
+Assert::IsTrue( linq.Window( 8 ).Empty() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( MovingSum )
+Assert::IsEqual( vector<int> { 53, 65, 102, 74, 122 }, linq.MovingSum( 3 ).to_vector() );
+Assert::IsEqual( vec, linq.MovingSum( 1 ).to_vector() );
+Assert::IsEqual( vector<int> { 187 }, linq.MovingSum( 7 ).to_vector() );
+Assert::IsTrue( linq.MovingSum( 8 ).Empty() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( MovingAverage )
+Assert::IsEqual( vector<int> { 17, 21, 34, 24, 40 }, linq.MovingAverage( 3 ).to_vector() );
+Assert::IsEqual( vector<double> { 6.5, 26.5, 26.0, 31.0, 31.0, 36.0 }, linq.MovingAverage<double>( 2 ).to_vector() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( MovingMinimumMaximum )
+Assert::IsEqual( vector<int> { 0, 12, 12, 12, 12 }, linq.MovingMinimum( 3 ).to_vector() );
+Assert::IsEqual( vector<int> { 40, 40, 50, 50, 60 }, linq.MovingMaximum( 3 ).to_vector() );
+Assert::IsEqual( vector<int> { 60 }, linq.MovingMaximum( 7 ).to_vector() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( MovingVariance )
+Assert::IsEqual( vector<double> { 42.25, 182.25, 196.0, 361.0, 361.0, 576.0 }, linq.MovingVariance<double>( 2 ).to_vector() );
+Assert::IsEqual( vector<double> { 0.0, 0.0 }, Linq::From( vector<double> { 2.5, 2.5, 2.5, 2.5 } ).MovingVariance( 3 ).to_vector() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Short )
+// No window fits in a source shorter than size, or in an empty one.
+const auto pair = Linq::From( vector<int> { 1, 2 } );
+const auto empty = Linq::From( vector<int>() );
+Assert::IsTrue( pair.MovingMinimum( 5 ).Empty() );
+Assert::IsTrue( pair.MovingMaximum( 5 ).Empty() );
+Assert::IsTrue( pair.MovingSum( 5 ).Empty() );
+Assert::IsTrue( pair.MovingVariance<double>( 5 ).Empty() );
+Assert::IsTrue( empty.MovingMinimum( 1 ).Empty() );
+Assert::IsTrue( empty.MovingMaximum( 3 ).Empty() );
+Assert::IsTrue( empty.MovingSum( 1 ).Empty() );
+Assert::IsTrue( empty.MovingVariance<double>( 3 ).Empty() );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Long )
+// The same as the aggregates of each Skip( i ).Take( size ), over enough windows for the restarts of the running values.
+vector<double> values;
+for( size_t i = 0; i < 1000; ++i )
+{
+	values.push_back( static_cast<double>( ( i * 7919 ) % 1009 ) / 8.0 - 50.0 );
+}
+auto series = Linq::From( values );
+const size_t size = 37;
+const auto sums = series.MovingSum( size );
+const auto averages = series.MovingAverage( size );
+const auto minimums = series.MovingMinimum( size );
+const auto maximums = series.MovingMaximum( size );
+const auto variances = series.MovingVariance( size );
+Assert::IsEqual( values.size() - size + 1, sums.Count() );
+for( size_t i = 0; i < sums.Count(); i += 13 )
+{
+	const auto window = series.Skip( i ).Take( size );
+	Assert::IsTrue( abs( window.Sum() - sums.At( i ) ) < 1e-9 );
+	Assert::IsTrue( abs( window.Average() - averages.At( i ) ) < 1e-9 );
+	Assert::IsEqual( window.Minimum(), minimums.At( i ) );
+	Assert::IsEqual( window.Maximum(), maximums.At( i ) );
+	Assert::IsTrue( abs( window.Variance() - variances.At( i ) ) < 1e-9 );
+}
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Errors )
+auto thrown = 0;
+try { linq.Chunk( 0 ); } catch( const out_of_range& ) { ++thrown; }
+try { linq.Window( 2, 0 ); } catch( const out_of_range& ) { ++thrown; }
+try { linq.MovingSum( 0 ); } catch( const out_of_range& ) { ++thrown; }
+Assert::IsEqual( 3, thrown );
+TEST_METHOD_END
+
+TEST_METHOD_BEGIN( Enumerable )
+Assert::IsEqual( vector<int> { 40, 40, 50, 50 }, Linq::AsEnumerable( vec ).Skip( 1 ).MovingMaximum( 2 ).Take( 4 ).to_vector() );
+Assert::IsEqual( static_cast<size_t>( 4 ), Linq::Range( 1, 10 ).Chunk( 3 ).Count() );
+TEST_METHOD_END
+
+TEST_CLASS_END
\ No newline at end of file
@@ -26,7 +26,59 @@
 #include <iterator>
 #include <stdexcept>
 #include <functional>
+#include <memory>
 #include <cmath>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <map>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <exception>
+#include <utility>
+#include <tuple>
+#include <string>
+#include <istream>
+#include <fstream>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <system_error>
+#include <chrono>
+#include <ostream>
+
+#if defined( __has_include )
+#if __has_include( <memory_resource> ) && ( __cplusplus >= 201703L || ( defined( _MSVC_LANG ) && _MSVC_LANG >= 201703L ) )
+#include <memory_resource>
+#endif
+#endif
+
+#if defined( __has_include ) && defined( __cpp_impl_coroutine )
+#if __has_include( <coroutine> )
+#include <coroutine>
+#include <optional>
+#define LINQ_HAS_COROUTINES
+#endif
+#endif
+
+#if defined( _WIN32 ) && !defined( __cplusplus_winrt )
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#elif defined( __unix__ ) || defined( __APPLE__ )
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if !defined( LINQ_DISABLE_SIMD ) && defined( __x86_64__ ) && defined( __linux__ ) && ( defined( __GNUC__ ) || defined( __clang__ ) )
+#include <immintrin.h>
+#endif
 
 #ifdef _MSC_VER
 #define constexpr inline
@@ -40,6 +92,24 @@
 
 #define ARITHMETICABLECHECK static_assert( ::std::is_arithmetic<typename Details::Wrap<T>::type>::value, "T is arithmeticable only." );
 
+// LINQINSTRUMENT opens the Instrumentation::Scope of an operator, LINQCOUNTED( f ) counts the calls of f in it,
+// LINQCOUNTEDIN( f ) counts them as the elements in of a deferred terminal, which does not know them beforehand,
+// and LINQINSTRUMENTOUT sets the elements and the bytes of the result. They are empty without LINQ_ENABLE_INSTRUMENTATION,
+// except that LINQINSTRUMENT still uses name, which may be a parameter (-Wunused-parameter).
+#ifdef LINQ_ENABLE_INSTRUMENTATION
+#define LINQINSTRUMENT( name ) LINQINSTRUMENTIN( name, Count() )
+#define LINQINSTRUMENTIN( name, count ) ::Linq::Instrumentation::Scope linqScope( name, static_cast<::std::uint64_t>( count ) );
+#define LINQCOUNTED( func ) ::Linq::Instrumentation::MakeCounted( func, linqScope )
+#define LINQCOUNTEDIN( func ) ::Linq::Instrumentation::MakeCountedIn( func, linqScope )
+#define LINQINSTRUMENTOUT( count, bytes ) linqScope.Output( static_cast<::std::uint64_t>( count ), static_cast<::std::uint64_t>( bytes ) );
+#else
+#define LINQINSTRUMENT( name ) static_cast<void>( name );
+#define LINQINSTRUMENTIN( name, count )
+#define LINQCOUNTED( func ) func
+#define LINQCOUNTEDIN( func ) func
+#define LINQINSTRUMENTOUT( count, bytes )
+#endif
+
 namespace Linq {
 
 #pragma region Detail
@@ -65,6 +135,63 @@ namespace Linq {
 		template<typename T> constexpr T^ Unwrap( const ::Platform::Agile<T^>& a ) { return a.Get(); }
 #endif
 
+		template<typename...> struct MakeVoid { using type = void; };
+
+		template<typename F, typename... Args> using InvokeResultT = decltype( ::std::declval<F&>()( ::std::declval<Args>()... ) );
+
+		// S if S is given explicitly, otherwise the decayed result type of the selector.
+		template<typename S, typename F, typename... Args>
+		using SelectResultT = ::std::conditional_t<::std::is_void<S>::value, ::std::decay_t<InvokeResultT<F, Args...>>, S>;
+
+		struct BorrowTag { };
+
+		// Allocator rebound to the (wrapped) element type U, e.g. for the result of a Select.
+		template<typename Allocator, typename U>
+		using RebindAllocatorT = typename ::std::allocator_traits<Allocator>::template rebind_alloc<typename Wrap<U>::type>;
+
+		// The bytes of the buffer of a container, as recorded by the instrumentation.
+		template<typename Container>
+		constexpr ::std::size_t CapacityBytes( const Container& container )
+		{
+			return container.capacity() * sizeof( typename Container::value_type );
+		}
+
+		// Containers whose elements can be borrowed as one contiguous block: built-in arrays, and classes with a data() pointer.
+		template<typename Container, typename = void>
+		struct IsContiguous
+			: ::std::is_array<Container>
+		{ };
+
+		template<typename Container>
+		struct IsContiguous<Container, typename MakeVoid<decltype( ::std::declval<const Container&>().data() )>::type>
+			: ::std::is_pointer<decltype( ::std::declval<const Container&>().data() )>
+		{ };
+
+		template<typename T, ::std::size_t N> constexpr const T* DataOf( const T( &container )[N] ) { return container; }
+		template<class Container> constexpr auto DataOf( const Container& container ) { return container.data(); }
+
+		// After this, first[r] is the element which would be there if [begin, end) were sorted, for every rank r in [rankFirst, rankLast).
+		// The ranks must be sorted, unique and in [begin - first, end - first). Each nth_element only sees the part between its neighbor ranks,
+		// so the partitioning work is shared by all the ranks.
+		template<typename RandomItr, typename RankItr>
+		constexpr void NthElements( RandomItr first, RandomItr begin, RandomItr end, RankItr rankFirst, RankItr rankLast )
+		{
+			while( rankFirst != rankLast )
+			{
+				const auto rank = rankFirst + ( rankLast - rankFirst ) / 2;
+				const auto nth = first + *rank;
+				::std::nth_element( begin, nth, end );
+				NthElements( first, begin, nth, rankFirst, rank );
+				begin = nth + 1;
+				rankFirst = rank + 1;
+			}
+		}
+
+		struct Identity
+		{
+			template<typename T> constexpr T operator()( const T& value ) const { return value; }
+		};
+
 		template<typename T> constexpr T Power2( T value ) { return value * value; }
 
 		template<typename T> constexpr T Sqrt( T value ) { return ::std::sqrt( value ); }
@@ -77,833 +204,6982 @@ namespace Linq {
 
 #pragma endregion
 
-	template<typename T>
-	class Vectorable
-	{
-	public:
-		using SizeType = typename ::std::vector<typename Details::Wrap<T>::type>::size_type;
-		using ItrType = typename ::std::vector<typename Details::Wrap<T>::type>::iterator;
+#pragma region Simd
+
+	// Kernels for the arithmetic aggregates of Vectorable.
+	// On x86-64 Linux with GCC or Clang, an SSE2, AVX2 or AVX-512 version is picked once at runtime from the CPU;
+	// everywhere else, or when LINQ_DISABLE_SIMD is defined, the scalar version is used.
+	//
+	// Floating-point accuracy:
+	// - float and double sums are accumulated in double, in 16 interleaved partial sums (element i goes to lane i % 16)
+	//   which are combined pairwise at the end. The error bound is about (n / 16 + 4) * eps(double) * sum(|x|),
+	//   tighter than a left fold, but the result may differ from ::std::accumulate in the last bits.
+	// - The lane layout and the combining order are the same at every ISA level and in the scalar version,
+	//   so the result does not depend on the CPU the program runs on. The squares of Variance go through an empty asm statement,
+	//   so that the compiler cannot fuse them into an FMA on the levels which have one.
+	// - Minimum and Maximum are exact. If the sequence contains NaN, the result is unspecified.
+	// Integer sums wrap around on overflow like the unsigned arithmetic of the same width.
+#if defined( __GNUC__ ) && !defined( __clang__ )
+	// GCC's AVX-512 intrinsics start from an undefined vector, which -Wall reports as maybe uninitialized once they are inlined here.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+	namespace Details { namespace Simd {
 
-	public:
+		enum class Level { Scalar, Sse2, Avx2, Avx512 };
 
-#pragma region Constructors
+		// 0: scalar only, 1: float, 2: double, 3: 32-bit integer, 4: 64-bit integer.
+		template<typename T>
+		struct Kind
+			: ::std::integral_constant<int,
+				::std::is_same<T, float>::value ? 1
+				: ::std::is_same<T, double>::value ? 2
+				: !::std::is_integral<T>::value || ::std::is_same<T, bool>::value ? 0
+				: sizeof( T ) == 4 ? 3
+				: sizeof( T ) == 8 ? 4
+				: 0>
+		{ };
 
-		constexpr Vectorable( SizeType size )
-			: data_( size )
-		{ }
+		template<bool IsMax, typename T> constexpr T Pick( T lhs, T rhs ) { return IsMax ? ( lhs < rhs ? rhs : lhs ) : ( rhs < lhs ? rhs : lhs ); }
 
-		constexpr Vectorable( T element, SizeType size )
-			: Vectorable( size )
+		// Deviation: ( value - mean )^2, otherwise value.
+		template<bool Deviation, typename V>
+		inline double Term( V value, double mean )
 		{
-			::std::fill( ::std::begin( data_ ), ::std::end( data_ ), Details::MakeWrap( element ) );
+			if( !Deviation )
+			{
+				return static_cast<double>( value );
+			}
+			auto ret = Power2( static_cast<double>( value ) - mean );
+#if defined( __x86_64__ ) && ( defined( __GNUC__ ) || defined( __clang__ ) )
+			__asm__( "" : "+v"( ret ) );
+#endif
+			return ret;
 		}
 
-		template<typename FwdItr>
-		constexpr Vectorable( FwdItr begin, FwdItr end )
-			: Vectorable( ::std::distance( begin, end ) )
+		inline double ReduceLanes( double( &lanes )[16] )
 		{
-			::std::transform(
-				begin,
-				end,
-				::std::begin( data_ ),
-				[]( T value ) { return Details::MakeWrap( value ); } );
+			for( ::std::size_t width = 8; width != 0; width /= 2 )
+			{
+				for( ::std::size_t i = 0; i < width; ++i )
+				{
+					lanes[i] += lanes[i + width];
+				}
+			}
+			return lanes[0];
 		}
 
-#pragma endregion
-
-#pragma region Getter
-
-		constexpr ItrType Begin() { return ::std::begin( data_ ); }
-		constexpr ItrType End() { return ::std::end( data_ ); }
-
-		constexpr T First() const { return *::std::begin( data_ ); }
-		constexpr T Last() const { return *--::std::end( data_ ); }
-		constexpr T At( SizeType index ) const
+		template<bool Deviation, typename V>
+		inline void AccumulateScalar( const V* first, ::std::size_t blocks, double mean, double( &lanes )[16] )
 		{
-			if( index > data_.size() )
+			for( ::std::size_t b = 0; b < blocks; ++b, first += 16 )
 			{
-				OUTOFRANGEEX
+				for( ::std::size_t i = 0; i < 16; ++i )
+				{
+					lanes[i] += Term<Deviation>( first[i], mean );
+				}
 			}
-
-			auto itr = ::std::begin( data_ );
-			::std::advance( itr, index );
-			return *itr;
 		}
 
-		constexpr T First( ::std::function<bool( T )> predicate ) const { return Where( predicate ).First(); }
-		constexpr T Last( ::std::function<bool( T )> predicate ) const { return Where( predicate ).Last(); }
-
-#pragma endregion
+		template<bool IsMax, typename T>
+		inline T MinMaxScalar( const T* first, ::std::size_t count )
+		{
+			auto ret = first[0];
+			for( ::std::size_t i = 1; i < count; ++i )
+			{
+				ret = Pick<IsMax>( ret, first[i] );
+			}
+			return ret;
+		}
 
-#pragma region Conditional Judgement
+#if !defined( LINQ_DISABLE_SIMD ) && defined( __x86_64__ ) && defined( __linux__ ) && ( defined( __GNUC__ ) || defined( __clang__ ) )
+#define LINQSIMDX86
 
-		constexpr bool All( T element ) const
+		inline Level CurrentLevel()
 		{
-			return ::std::all_of( ::std::cbegin( data_ ), ::std::cend( data_ ), ::std::bind( ::std::equal_to<T>(), ::std::placeholders::_1, element ) );
+			static const Level level = []
+			{
+				__builtin_cpu_init();
+				return __builtin_cpu_supports( "avx512f" ) ? Level::Avx512
+					: __builtin_cpu_supports( "avx2" ) ? Level::Avx2
+					: Level::Sse2;
+			}();
+			return level;
 		}
-		constexpr bool All( ::std::function<bool( T )> predicate ) const
+
+		// Float and double lanes. Each function adds "blocks" blocks of 16 elements into lanes.
+
+		template<bool Deviation>
+		__attribute__( ( target( "sse2" ) ) ) inline void AccumulateSse2( const double* first, ::std::size_t blocks, double mean, double( &lanes )[16] )
 		{
-			return ::std::all_of( ::std::cbegin( data_ ), ::std::cend( data_ ), predicate );
+			__m128d acc[8];
+			for( int k = 0; k < 8; ++k ) acc[k] = _mm_loadu_pd( lanes + 2 * k );
+			const auto m = _mm_set1_pd( mean );
+			for( ::std::size_t b = 0; b < blocks; ++b, first += 16 )
+			{
+				for( int k = 0; k < 8; ++k )
+				{
+					auto v = _mm_loadu_pd( first + 2 * k );
+					if( Deviation ) { v = _mm_sub_pd( v, m ); v = _mm_mul_pd( v, v ); __asm__( "" : "+v"( v ) ); }
+					acc[k] = _mm_add_pd( acc[k], v );
+				}
+			}
+			for( int k = 0; k < 8; ++k ) _mm_storeu_pd( lanes + 2 * k, acc[k] );
 		}
 
-		constexpr bool Any( T element ) const
+		template<bool Deviation>
+		__attribute__( ( target( "sse2" ) ) ) inline void AccumulateSse2( const float* first, ::std::size_t blocks, double mean, double( &lanes )[16] )
 		{
-			return ::std::any_of( ::std::cbegin( data_ ), ::std::cend( data_ ), ::std::bind( ::std::equal_to<T>(), ::std::placeholders::_1, element ) );
+			__m128d acc[8];
+			for( int k = 0; k < 8; ++k ) acc[k] = _mm_loadu_pd( lanes + 2 * k );
+			const auto m = _mm_set1_pd( mean );
+			for( ::std::size_t b = 0; b < blocks; ++b, first += 16 )
+			{
+				for( int k = 0; k < 4; ++k )
+				{
+					const auto f = _mm_loadu_ps( first + 4 * k );
+					__m128d v[2] = { _mm_cvtps_pd( f ), _mm_cvtps_pd( _mm_movehl_ps( f, f ) ) };
+					for( int h = 0; h < 2; ++h )
+					{
+						if( Deviation ) { v[h] = _mm_sub_pd( v[h], m ); v[h] = _mm_mul_pd( v[h], v[h] ); __asm__( "" : "+v"( v[h] ) ); }
+						acc[2 * k + h] = _mm_add_pd( acc[2 * k + h], v[h] );
+					}
+				}
+			}
+			for( int k = 0; k < 8; ++k ) _mm_storeu_pd( lanes + 2 * k, acc[k] );
 		}
-		constexpr bool Any( ::std::function<bool( T )> predicate ) const
+
+		template<bool Deviation>
+		__attribute__( ( target( "avx2" ) ) ) inline void AccumulateAvx2( const double* first, ::std::size_t blocks, double mean, double( &lanes )[16] )
 		{
-			return ::std::any_of( ::std::cbegin( data_ ), ::std::cend( data_ ), predicate );
+			__m256d acc[4];
+			for( int k = 0; k < 4; ++k ) acc[k] = _mm256_loadu_pd( lanes + 4 * k );
+			const auto m = _mm256_set1_pd( mean );
+			for( ::std::size_t b = 0; b < blocks; ++b, first += 16 )
+			{
+				for( int k = 0; k < 4; ++k )
+				{
+					auto v = _mm256_loadu_pd( first + 4 * k );
+					if( Deviation ) { v = _mm256_sub_pd( v, m ); v = _mm256_mul_pd( v, v ); __asm__( "" : "+v"( v ) ); }
+					acc[k] = _mm256_add_pd( acc[k], v );
+				}
+			}
+			for( int k = 0; k < 4; ++k ) _mm256_storeu_pd( lanes + 4 * k, acc[k] );
 		}
 
-		constexpr bool None( T element ) const
+		template<bool Deviation>
+		__attribute__( ( target( "avx2" ) ) ) inline void AccumulateAvx2( const float* first, ::std::size_t blocks, double mean, double( &lanes )[16] )
 		{
-			return ::std::none_of( ::std::cbegin( data_ ), ::std::cend( data_ ), ::std::bind( ::std::equal_to<T>(), ::std::placeholders::_1, element ) );
+			__m256d acc[4];
+			for( int k = 0; k < 4; ++k ) acc[k] = _mm256_loadu_pd( lanes + 4 * k );
+			const auto m = _mm256_set1_pd( mean );
+			for( ::std::size_t b = 0; b < blocks; ++b, first += 16 )
+			{
+				for( int k = 0; k < 2; ++k )
+				{
+					const auto f = _mm256_loadu_ps( first + 8 * k );
+					__m256d v[2] = { _mm256_cvtps_pd( _mm256_castps256_ps128( f ) ), _mm256_cvtps_pd( _mm256_extractf128_ps( f, 1 ) ) };
+					for( int h = 0; h < 2; ++h )
+					{
+						if( Deviation ) { v[h] = _mm256_sub_pd( v[h], m ); v[h] = _mm256_mul_pd( v[h], v[h] ); __asm__( "" : "+v"( v[h] ) ); }
+						acc[2 * k + h] = _mm256_add_pd( acc[2 * k + h], v[h] );
+					}
+				}
+			}
+			for( int k = 0; k < 4; ++k ) _mm256_storeu_pd( lanes + 4 * k, acc[k] );
 		}
-		constexpr bool None( ::std::function<bool( T )> predicate ) const
+
+		template<bool Deviation>
+		__attribute__( ( target( "avx512f" ) ) ) inline void AccumulateAvx512( const double* first, ::std::size_t blocks, double mean, double( &lanes )[16] )
 		{
-			return ::std::none_of( ::std::cbegin( data_ ), ::std::cend( data_ ), predicate );
+			__m512d acc[2] = { _mm512_loadu_pd( lanes ), _mm512_loadu_pd( lanes + 8 ) };
+			const auto m = _mm512_set1_pd( mean );
+			for( ::std::size_t b = 0; b < blocks; ++b, first += 16 )
+			{
+				for( int k = 0; k < 2; ++k )
+				{
+					auto v = _mm512_loadu_pd( first + 8 * k );
+					if( Deviation ) { v = _mm512_sub_pd( v, m ); v = _mm512_mul_pd( v, v ); __asm__( "" : "+v"( v ) ); }
+					acc[k] = _mm512_add_pd( acc[k], v );
+				}
+			}
+			_mm512_storeu_pd( lanes, acc[0] );
+			_mm512_storeu_pd( lanes + 8, acc[1] );
 		}
 
-		constexpr bool Empty() const
+		template<bool Deviation>
+		__attribute__( ( target( "avx512f" ) ) ) inline void AccumulateAvx512( const float* first, ::std::size_t blocks, double mean, double( &lanes )[16] )
 		{
-			return data_.empty();
+			__m512d acc[2] = { _mm512_loadu_pd( lanes ), _mm512_loadu_pd( lanes + 8 ) };
+			const auto m = _mm512_set1_pd( mean );
+			for( ::std::size_t b = 0; b < blocks; ++b, first += 16 )
+			{
+				__m512d v[2] = { _mm512_cvtps_pd( _mm256_loadu_ps( first ) ), _mm512_cvtps_pd( _mm256_loadu_ps( first + 8 ) ) };
+				for( int k = 0; k < 2; ++k )
+				{
+					if( Deviation ) { v[k] = _mm512_sub_pd( v[k], m ); v[k] = _mm512_mul_pd( v[k], v[k] ); __asm__( "" : "+v"( v[k] ) ); }
+					acc[k] = _mm512_add_pd( acc[k], v[k] );
+				}
+			}
+			_mm512_storeu_pd( lanes, acc[0] );
+			_mm512_storeu_pd( lanes + 8, acc[1] );
 		}
 
-		constexpr bool SequenceEqual( Vectorable second ) const
+		// Integer sums. The lanes are added as unsigned values, so the wrap around is well-defined.
+
+		template<typename I>
+		__attribute__( ( target( "sse2" ) ) ) inline I SumIntegerSse2( const I* first, ::std::size_t count )
 		{
-			return Count() == second.Count() && ::std::equal( ::std::cbegin( data_ ), ::std::cend( data_ ), ::std::cbegin( second.data_ ) );
+			auto acc = _mm_setzero_si128();
+			::std::size_t i = 0;
+			for( ; i + 16 / sizeof( I ) <= count; i += 16 / sizeof( I ) )
+			{
+				const auto v = _mm_loadu_si128( reinterpret_cast<const __m128i*>( first + i ) );
+				acc = sizeof( I ) == 4 ? _mm_add_epi32( acc, v ) : _mm_add_epi64( acc, v );
+			}
+			::std::make_unsigned_t<I> lanes[16 / sizeof( I )];
+			_mm_storeu_si128( reinterpret_cast<__m128i*>( lanes ), acc );
+			auto ret = ::std::accumulate( ::std::begin( lanes ), ::std::end( lanes ), ::std::make_unsigned_t<I>() );
+			for( ; i < count; ++i ) ret += static_cast<::std::make_unsigned_t<I>>( first[i] );
+			return static_cast<I>( ret );
 		}
 
-		constexpr bool Contain( T element ) const
+		template<typename I>
+		__attribute__( ( target( "avx2" ) ) ) inline I SumIntegerAvx2( const I* first, ::std::size_t count )
 		{
-			return ::std::find( ::std::cbegin( data_ ), ::std::cend( data_ ), element ) != ::std::cend( data_ );
+			auto acc = _mm256_setzero_si256();
+			::std::size_t i = 0;
+			for( ; i + 32 / sizeof( I ) <= count; i += 32 / sizeof( I ) )
+			{
+				const auto v = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( first + i ) );
+				acc = sizeof( I ) == 4 ? _mm256_add_epi32( acc, v ) : _mm256_add_epi64( acc, v );
+			}
+			::std::make_unsigned_t<I> lanes[32 / sizeof( I )];
+			_mm256_storeu_si256( reinterpret_cast<__m256i*>( lanes ), acc );
+			auto ret = ::std::accumulate( ::std::begin( lanes ), ::std::end( lanes ), ::std::make_unsigned_t<I>() );
+			for( ; i < count; ++i ) ret += static_cast<::std::make_unsigned_t<I>>( first[i] );
+			return static_cast<I>( ret );
 		}
-		constexpr bool Contain( Vectorable second ) const
+
+		template<typename I>
+		__attribute__( ( target( "avx512f" ) ) ) inline I SumIntegerAvx512( const I* first, ::std::size_t count )
 		{
-			return second.All( [&]( T value )
+			auto acc = _mm512_setzero_si512();
+			::std::size_t i = 0;
+			for( ; i + 64 / sizeof( I ) <= count; i += 64 / sizeof( I ) )
 			{
-				return ::std::find( ::std::cbegin( data_ ), ::std::cend( data_ ), value ) != ::std::cend( data_ );
-			} );
+				const auto v = _mm512_loadu_si512( first + i );
+				acc = sizeof( I ) == 4 ? _mm512_add_epi32( acc, v ) : _mm512_add_epi64( acc, v );
+			}
+			::std::make_unsigned_t<I> lanes[64 / sizeof( I )];
+			_mm512_storeu_si512( lanes, acc );
+			auto ret = ::std::accumulate( ::std::begin( lanes ), ::std::end( lanes ), ::std::make_unsigned_t<I>() );
+			for( ; i < count; ++i ) ret += static_cast<::std::make_unsigned_t<I>>( first[i] );
+			return static_cast<I>( ret );
 		}
-		constexpr bool Include( T element ) const { return Contain( element ); }
-		constexpr bool Include( Vectorable second ) const { return Contain( second ); }
 
-#pragma endregion
-
-#pragma region Basic Calc
+		// Minimum and maximum. count must not be 0.
 
-		constexpr SizeType Count() const { return data_.size(); }
-		constexpr SizeType Count( T element ) const
+		template<bool IsMax>
+		__attribute__( ( target( "sse2" ) ) ) inline float MinMaxSse2( const float* first, ::std::size_t count )
 		{
-			return ::std::count( ::std::cbegin( data_ ), ::std::cend( data_ ), element );
-		}
-		constexpr SizeType Count( ::std::function<bool( T )> predicate ) const
-		{
-			return ::std::count_if( ::std::cbegin( data_ ), ::std::cend( data_ ), predicate );
+			auto acc = _mm_set1_ps( first[0] );
+			::std::size_t i = 0;
+			for( ; i + 4 <= count; i += 4 )
+			{
+				const auto v = _mm_loadu_ps( first + i );
+				acc = IsMax ? _mm_max_ps( acc, v ) : _mm_min_ps( acc, v );
+			}
+			float lanes[4];
+			_mm_storeu_ps( lanes, acc );
+			auto ret = MinMaxScalar<IsMax>( lanes, 4 );
+			for( ; i < count; ++i ) ret = Pick<IsMax>( ret, first[i] );
+			return ret;
 		}
 
-		constexpr T Sum() const
+		template<bool IsMax>
+		__attribute__( ( target( "sse2" ) ) ) inline double MinMaxSse2( const double* first, ::std::size_t count )
 		{
-			ARITHMETICABLECHECK
-
-			return ::std::accumulate( ::std::cbegin( data_ ), ::std::cend( data_ ), static_cast<T>( 0 ) );
+			auto acc = _mm_set1_pd( first[0] );
+			::std::size_t i = 0;
+			for( ; i + 2 <= count; i += 2 )
+			{
+				const auto v = _mm_loadu_pd( first + i );
+				acc = IsMax ? _mm_max_pd( acc, v ) : _mm_min_pd( acc, v );
+			}
+			double lanes[2];
+			_mm_storeu_pd( lanes, acc );
+			auto ret = MinMaxScalar<IsMax>( lanes, 2 );
+			for( ; i < count; ++i ) ret = Pick<IsMax>( ret, first[i] );
+			return ret;
 		}
 
-		constexpr T Average() const
+		// SSE2 has no 32-bit min/max, so it is a compare and a bitwise select.
+		template<bool IsMax, typename I>
+		__attribute__( ( target( "sse2" ) ) ) inline ::std::enable_if_t<::std::is_integral<I>::value && sizeof( I ) == 4, I> MinMaxSse2( const I* first, ::std::size_t count )
 		{
-			ARITHMETICABLECHECK
-
-			return Sum() / static_cast<T>( Count() );
+			auto acc = _mm_set1_epi32( first[0] );
+			::std::size_t i = 0;
+			for( ; i + 4 <= count; i += 4 )
+			{
+				const auto v = _mm_loadu_si128( reinterpret_cast<const __m128i*>( first + i ) );
+				const auto mask = IsMax ? _mm_cmpgt_epi32( v, acc ) : _mm_cmplt_epi32( v, acc );
+				acc = _mm_or_si128( _mm_and_si128( mask, v ), _mm_andnot_si128( mask, acc ) );
+			}
+			I lanes[4];
+			_mm_storeu_si128( reinterpret_cast<__m128i*>( lanes ), acc );
+			auto ret = MinMaxScalar<IsMax>( lanes, 4 );
+			for( ; i < count; ++i ) ret = Pick<IsMax>( ret, first[i] );
+			return ret;
 		}
-		template<typename S>
-		constexpr S Average() const
-		{
-			ARITHMETICABLECHECK
-
-			return Cast<S>().Average();
-		}	
-		constexpr T Mean() const { return Average(); }
-		template<typename S> constexpr S Mean() const { return Average<S>(); }
 
-		constexpr T Minimum() const
+		// SSE2 has no 64-bit compare either.
+		template<bool IsMax, typename I>
+		inline ::std::enable_if_t<::std::is_integral<I>::value && sizeof( I ) == 8, I> MinMaxSse2( const I* first, ::std::size_t count )
 		{
-			ARITHMETICABLECHECK
-
-			return *::std::min_element( ::std::cbegin( data_ ), ::std::cend( data_ ) );
+			return MinMaxScalar<IsMax>( first, count );
 		}
 
-		constexpr T Maximum() const
+		template<bool IsMax>
+		__attribute__( ( target( "avx2" ) ) ) inline float MinMaxAvx2( const float* first, ::std::size_t count )
 		{
-			ARITHMETICABLECHECK
-
-			return *::std::max_element( ::std::cbegin( data_ ), ::std::cend( data_ ) );
+			auto acc = _mm256_set1_ps( first[0] );
+			::std::size_t i = 0;
+			for( ; i + 8 <= count; i += 8 )
+			{
+				const auto v = _mm256_loadu_ps( first + i );
+				acc = IsMax ? _mm256_max_ps( acc, v ) : _mm256_min_ps( acc, v );
+			}
+			float lanes[8];
+			_mm256_storeu_ps( lanes, acc );
+			auto ret = MinMaxScalar<IsMax>( lanes, 8 );
+			for( ; i < count; ++i ) ret = Pick<IsMax>( ret, first[i] );
+			return ret;
 		}
 
-		constexpr T Median() const
+		template<bool IsMax>
+		__attribute__( ( target( "avx2" ) ) ) inline double MinMaxAvx2( const double* first, ::std::size_t count )
 		{
-			ARITHMETICABLECHECK
-
-			const auto s = OrderBy();
-			const auto count = s.Count();
-			auto halfCount = count / static_cast<SizeType>( 2 );
-			return count % 2 == 0 ? ( s.At( halfCount - 1 ) + s.At( halfCount ) ) / 2 : s.At( halfCount );
+			auto acc = _mm256_set1_pd( first[0] );
+			::std::size_t i = 0;
+			for( ; i + 4 <= count; i += 4 )
+			{
+				const auto v = _mm256_loadu_pd( first + i );
+				acc = IsMax ? _mm256_max_pd( acc, v ) : _mm256_min_pd( acc, v );
+			}
+			double lanes[4];
+			_mm256_storeu_pd( lanes, acc );
+			auto ret = MinMaxScalar<IsMax>( lanes, 4 );
+			for( ; i < count; ++i ) ret = Pick<IsMax>( ret, first[i] );
+			return ret;
 		}
 
-		constexpr T Variance() const
+		template<bool IsMax, typename I>
+		__attribute__( ( target( "avx2" ) ) ) inline ::std::enable_if_t<::std::is_integral<I>::value && sizeof( I ) == 4, I> MinMaxAvx2( const I* first, ::std::size_t count )
 		{
-			ARITHMETICABLECHECK
-
-			const auto average = Average();
-			const auto count = static_cast<T>( Count() );
-			return Aggregate<T>(
-				0,
-				[average]( T value, T next ) { return value + Details::Power2( next - average ); },
-				[count]( T value ) { return value / count; } );
+			auto acc = _mm256_set1_epi32( first[0] );
+			::std::size_t i = 0;
+			for( ; i + 8 <= count; i += 8 )
+			{
+				const auto v = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( first + i ) );
+				acc = IsMax ? _mm256_max_epi32( acc, v ) : _mm256_min_epi32( acc, v );
+			}
+			I lanes[8];
+			_mm256_storeu_si256( reinterpret_cast<__m256i*>( lanes ), acc );
+			auto ret = MinMaxScalar<IsMax>( lanes, 8 );
+			for( ; i < count; ++i ) ret = Pick<IsMax>( ret, first[i] );
+			return ret;
 		}
-		constexpr T StandardDeviation() const { return static_cast<T>( Details::Sqrt( Variance() ) ); }
 
-		constexpr T Aggregate( T seed, ::std::function<T( T, T )> func ) const
+		// AVX2 has a 64-bit compare but no 64-bit min/max, so it is a compare and a blend.
+		template<bool IsMax, typename I>
+		__attribute__( ( target( "avx2" ) ) ) inline ::std::enable_if_t<::std::is_integral<I>::value && sizeof( I ) == 8, I> MinMaxAvx2( const I* first, ::std::size_t count )
 		{
-			ARITHMETICABLECHECK
-
-			return ::std::accumulate( ::std::cbegin( data_ ), ::std::cend( data_ ), seed, func );
+			auto acc = _mm256_set1_epi64x( static_cast<long long>( first[0] ) );
+			::std::size_t i = 0;
+			for( ; i + 4 <= count; i += 4 )
+			{
+				const auto v = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( first + i ) );
+				const auto mask = IsMax ? _mm256_cmpgt_epi64( v, acc ) : _mm256_cmpgt_epi64( acc, v );
+				acc = _mm256_blendv_epi8( acc, v, mask );
+			}
+			I lanes[4];
+			_mm256_storeu_si256( reinterpret_cast<__m256i*>( lanes ), acc );
+			auto ret = MinMaxScalar<IsMax>( lanes, 4 );
+			for( ; i < count; ++i ) ret = Pick<IsMax>( ret, first[i] );
+			return ret;
 		}
 
-		template<typename S>
-		constexpr S Aggregate( T seed, ::std::function<T( T, T )> func, ::std::function<S( T )> resultSelector ) const
+		template<bool IsMax>
+		__attribute__( ( target( "avx512f" ) ) ) inline float MinMaxAvx512( const float* first, ::std::size_t count )
 		{
-			ARITHMETICABLECHECK
-
-			return resultSelector( ::std::accumulate( ::std::cbegin( data_ ), ::std::cend( data_ ), seed, func ) );
+			auto acc = _mm512_set1_ps( first[0] );
+			::std::size_t i = 0;
+			for( ; i + 16 <= count; i += 16 )
+			{
+				const auto v = _mm512_loadu_ps( first + i );
+				acc = IsMax ? _mm512_max_ps( acc, v ) : _mm512_min_ps( acc, v );
+			}
+			float lanes[16];
+			_mm512_storeu_ps( lanes, acc );
+			auto ret = MinMaxScalar<IsMax>( lanes, 16 );
+			for( ; i < count; ++i ) ret = Pick<IsMax>( ret, first[i] );
+			return ret;
 		}
 
-#pragma endregion
-
-#pragma region Filtering
-
-#ifdef __cplusplus_winrt
-		template<typename T>
-		Vectorable OfType() const
+		template<bool IsMax>
+		__attribute__( ( target( "avx512f" ) ) ) inline double MinMaxAvx512( const double* first, ::std::size_t count )
 		{
-			return OfType( T::typeid );
+			auto acc = _mm512_set1_pd( first[0] );
+			::std::size_t i = 0;
+			for( ; i + 8 <= count; i += 8 )
+			{
+				const auto v = _mm512_loadu_pd( first + i );
+				acc = IsMax ? _mm512_max_pd( acc, v ) : _mm512_min_pd( acc, v );
+			}
+			double lanes[8];
+			_mm512_storeu_pd( lanes, acc );
+			auto ret = MinMaxScalar<IsMax>( lanes, 8 );
+			for( ; i < count; ++i ) ret = Pick<IsMax>( ret, first[i] );
+			return ret;
 		}
 
-		Vectorable OfType( Windows::UI::Xaml::Interop::TypeName typeName ) const
+		template<bool IsMax, typename I>
+		__attribute__( ( target( "avx512f" ) ) ) inline ::std::enable_if_t<::std::is_integral<I>::value, I> MinMaxAvx512( const I* first, ::std::size_t count )
 		{
-			static_assert( __is_valid_winrt_type( typename Details::Wrap<T>::type ), "T is winrt type only." );
-
-			return Where( [typeName]( typename Details::Wrap<T>::type value )
+			constexpr ::std::size_t width = 64 / sizeof( I );
+			auto acc = sizeof( I ) == 4 ? _mm512_set1_epi32( static_cast<int>( first[0] ) ) : _mm512_set1_epi64( static_cast<long long>( first[0] ) );
+			::std::size_t i = 0;
+			for( ; i + width <= count; i += width )
 			{
-				return ::Windows::UI::Xaml::Interop::TypeName( Details::Unwrap( value )->GetType() ).Name == typeName.Name;
-			} );
-		}
-#endif	
-		constexpr Vectorable EqualTo( T value ) const
-		{
-			return Where( ::std::bind( ::std::equal_to<>(), ::std::placeholders::_1, value ) );
+				const auto v = _mm512_loadu_si512( first + i );
+				acc = sizeof( I ) == 4
+					? ( IsMax ? _mm512_max_epi32( acc, v ) : _mm512_min_epi32( acc, v ) )
+					: ( IsMax ? _mm512_max_epi64( acc, v ) : _mm512_min_epi64( acc, v ) );
+			}
+			I lanes[width];
+			_mm512_storeu_si512( lanes, acc );
+			auto ret = MinMaxScalar<IsMax>( lanes, width );
+			for( ; i < count; ++i ) ret = Pick<IsMax>( ret, first[i] );
+			return ret;
 		}
 
-		constexpr Vectorable NotEqualTo( T value ) const
+#else
+		constexpr Level CurrentLevel() { return Level::Scalar; }
+#endif
+
+		template<bool Deviation, typename V>
+		inline void AccumulateLanes( const V* first, ::std::size_t blocks, double mean, double( &lanes )[16], ::std::false_type )
 		{
-			return Where( ::std::bind( ::std::not_equal_to<>(), ::std::placeholders::_1, value ) );
+			AccumulateScalar<Deviation>( first, blocks, mean, lanes );
 		}
-
-		constexpr Vectorable LessThan( T value ) const
+		template<bool Deviation, typename V>
+		inline void AccumulateLanes( const V* first, ::std::size_t blocks, double mean, double( &lanes )[16], ::std::true_type )
 		{
-			ARITHMETICABLECHECK
-
-			return Where( ::std::bind( ::std::less<>(), ::std::placeholders::_1, value ) );
+			switch( CurrentLevel() )
+			{
+#ifdef LINQSIMDX86
+			case Level::Avx512: AccumulateAvx512<Deviation>( first, blocks, mean, lanes ); break;
+			case Level::Avx2: AccumulateAvx2<Deviation>( first, blocks, mean, lanes ); break;
+			case Level::Sse2: AccumulateSse2<Deviation>( first, blocks, mean, lanes ); break;
+#endif
+			default: AccumulateScalar<Deviation>( first, blocks, mean, lanes ); break;
+			}
 		}
 
-		constexpr Vectorable LessThanOrEqualTo( T value ) const
+		// Only float and double have lane kernels; the other types are converted to double one by one.
+		template<bool Deviation, typename V>
+		inline double SumLanes( const V* first, ::std::size_t count, double mean )
 		{
-			ARITHMETICABLECHECK
-
-			return Where( ::std::bind( ::std::less_equal<>(), ::std::placeholders::_1, value ) );
+			double lanes[16] = { };
+			const auto blocks = count / 16;
+			AccumulateLanes<Deviation>( first, blocks, mean, lanes, ::std::integral_constant<bool, Kind<V>::value == 1 || Kind<V>::value == 2>() );
+			for( auto i = blocks * 16; i < count; ++i )
+			{
+				lanes[i % 16] += Term<Deviation>( first[i], mean );
+			}
+			return ReduceLanes( lanes );
 		}
 
-		constexpr Vectorable GreaterThan( T value ) const
+		template<typename T>
+		inline T SumImpl( const T* first, ::std::size_t count, ::std::integral_constant<int, 0> )
 		{
-			ARITHMETICABLECHECK
-
-			return Where( ::std::bind( ::std::greater<>(), ::std::placeholders::_1, value ) );
+			return ::std::accumulate( first, first + count, static_cast<T>( 0 ) );
 		}
-
-		constexpr Vectorable GreaterThanOrEqualTo( T value ) const
+		template<typename T>
+		inline T SumImpl( const T* first, ::std::size_t count, ::std::integral_constant<int, 1> )
 		{
-			ARITHMETICABLECHECK
-
-			return Where( ::std::bind( ::std::greater_equal<>(), ::std::placeholders::_1, value ) );
+			return static_cast<T>( SumLanes<false>( first, count, 0.0 ) );
 		}
-
-		constexpr Vectorable Where( ::std::function<bool( T )> predicate ) const
+		template<typename T>
+		inline T SumImpl( const T* first, ::std::size_t count, ::std::integral_constant<int, 2> )
 		{
-			Vectorable ret( data_.size() );
-			auto itr = ::std::copy_if( ::std::cbegin( data_ ), ::std::cend( data_ ), ::std::begin( ret.data_ ), predicate );
-			ret.data_.resize( ::std::distance( ::std::begin( ret.data_ ), itr ) );
-			return ::std::move( ret );
+			return SumLanes<false>( first, count, 0.0 );
 		}
-
-#pragma endregion
-
-#pragma region Basic Operation
-
-		constexpr Vectorable Skip( SizeType count ) const
+		template<typename T, int K>
+		inline T SumImpl( const T* first, ::std::size_t count, ::std::integral_constant<int, K> )
 		{
-			const auto size = data_.size();
-
-			if( count > size )
+			switch( CurrentLevel() )
 			{
-				OUTOFRANGEEX
+#ifdef LINQSIMDX86
+			case Level::Avx512: return SumIntegerAvx512( first, count );
+			case Level::Avx2: return SumIntegerAvx2( first, count );
+			case Level::Sse2: return SumIntegerSse2( first, count );
+#endif
+			default:
+				::std::make_unsigned_t<T> ret = 0;
+				for( ::std::size_t i = 0; i < count; ++i ) ret += static_cast<::std::make_unsigned_t<T>>( first[i] );
+				return static_cast<T>( ret );
 			}
-
-			Vectorable ret( size - count );
-			auto begin = ::std::cbegin( data_ );
-			::std::advance( begin, count );
-			::std::copy( begin, ::std::cend( data_ ), ::std::begin( ret.data_ ) );
-			return ::std::move( ret );
 		}
 
-		constexpr Vectorable SkipWhile( ::std::function<bool( T )> predicate ) const
+		template<bool IsMax, typename T>
+		inline T MinMaxImpl( const T* first, ::std::size_t count, ::std::false_type )
 		{
-			SizeType i = 0;
-			for( ; i < data_.size(); ++i )
+			return MinMaxScalar<IsMax>( first, count );
+		}
+		template<bool IsMax, typename T>
+		inline T MinMaxImpl( const T* first, ::std::size_t count, ::std::true_type )
+		{
+			switch( CurrentLevel() )
 			{
-				const auto data = data_[i];
-				if( !predicate( data ) )
-				{
-					break;
-				}
+#ifdef LINQSIMDX86
+			case Level::Avx512: return MinMaxAvx512<IsMax>( first, count );
+			case Level::Avx2: return MinMaxAvx2<IsMax>( first, count );
+			case Level::Sse2: return MinMaxSse2<IsMax>( first, count );
+#endif
+			default: return MinMaxScalar<IsMax>( first, count );
 			}
-
-			return Skip( i );
 		}
 
-		constexpr Vectorable Take( SizeType count ) const
-		{
-			return TakeWhile( [&count]( T ) { return count-- != 0; } );
-		}
+		// Unsigned integers have no kernel for minimum and maximum.
+		template<typename T>
+		using HasMinMaxKernel = ::std::integral_constant<bool, Kind<T>::value != 0 && ::std::is_signed<T>::value>;
 
-		constexpr Vectorable TakeWhile( ::std::function<bool( T )> predicate ) const
-		{
-			const auto size = data_.size();
+		template<typename T> inline T Sum( const T* first, ::std::size_t count ) { return SumImpl( first, count, Kind<T>() ); }
 
-			Vectorable ret( size );
+		// count must not be 0.
+		template<typename T> inline T Minimum( const T* first, ::std::size_t count ) { return MinMaxImpl<false>( first, count, HasMinMaxKernel<T>() ); }
+		template<typename T> inline T Maximum( const T* first, ::std::size_t count ) { return MinMaxImpl<true>( first, count, HasMinMaxKernel<T>() ); }
 
+		// Sum and sum of ( x - mean )^2 in double, in the lane layout described above, for any arithmetic type.
+		template<typename T> inline double SumInDouble( const T* first, ::std::size_t count ) { return SumLanes<false>( first, count, 0.0 ); }
+		template<typename T> inline double SumOfSquaredDeviations( const T* first, ::std::size_t count, double mean ) { return SumLanes<true>( first, count, mean ); }
+
+	} }
+#if defined( __GNUC__ ) && !defined( __clang__ )
+#pragma GCC diagnostic pop
+#endif
+
+#pragma endregion
+
+#pragma region Hash
+
+	namespace Details {
+
+		// Spreads the bits of a hash over the high bits, so that identity hashes (::std::hash<int>) of patterned keys
+		// do not collide in the low bits which pick the slot. (Fibonacci hashing.)
+		constexpr ::std::size_t MixHash( ::std::size_t hash )
+		{
+			return sizeof( ::std::size_t ) == 8
+				? static_cast<::std::size_t>( static_cast<unsigned long long>( hash ) * 0x9E3779B97F4A7C15ull )
+				: hash * static_cast<::std::size_t>( 0x9E3779B9u );
+		}
+
+		// A set of keys in open addressing with linear probing. The keys are stored contiguously in insertion order
+		// and get the dense ids 0, 1, 2, ...; the slots only hold the hash and the id, so probing touches 16 bytes per slot.
+		// The table is kept at most half full.
+		template<typename Key, typename Hash, typename KeyEqual>
+		class FlatHashSet
+		{
+		public:
+			using SizeType = ::std::size_t;
+
+			static const SizeType npos = static_cast<SizeType>( -1 );
+
+		public:
+			FlatHashSet( Hash hash, KeyEqual equal, SizeType expectedCount = 0 )
+				: hash_( hash )
+				, equal_( equal )
+				, slots_( Capacity( expectedCount ) )
+			{
+				keys_.reserve( expectedCount );
+			}
+
+			// Returns the id of key and whether it was inserted by this call.
+			::std::pair<SizeType, bool> Insert( const Key& key )
+			{
+				return Insert( key, key );
+			}
+			// Inserts an element constructed from source, looking it up with key first.
+			template<typename Source>
+			::std::pair<SizeType, bool> Insert( const Key& key, Source&& source )
+			{
+				const auto hash = MixHash( hash_( key ) );
+				auto slot = Probe( key, hash );
+				if( slot->id != npos )
+				{
+					return ::std::make_pair( slot->id, false );
+				}
+
+				if( ( keys_.size() + 1 ) * 2 > slots_.size() )
+				{
+					Grow();
+					slot = Probe( key, hash );
+				}
+				slot->hash = hash;
+				slot->id = keys_.size();
+				keys_.emplace_back( ::std::forward<Source>( source ) );
+				return ::std::make_pair( slot->id, true );
+			}
+
+			SizeType Find( const Key& key ) const
+			{
+				return Probe( key, MixHash( hash_( key ) ) )->id;
+			}
+
+			SizeType Count() const { return keys_.size(); }
+			const Key& operator[]( SizeType id ) const { return keys_[id]; }
+			const ::std::vector<Key>& Keys() const { return keys_; }
+			::std::vector<Key> ReleaseKeys() { return ::std::move( keys_ ); }
+
+		private:
+			struct Slot
+			{
+				SizeType hash = 0;
+				SizeType id = npos;
+			};
+
+			static SizeType Capacity( SizeType count )
+			{
+				SizeType capacity = 16;
+				while( capacity < count * 2 )
+				{
+					capacity *= 2;
+				}
+				return capacity;
+			}
+
+			// Folds the high bits, where the multiplication of MixHash put the entropy, into the index.
+			static SizeType SlotOf( SizeType hash, SizeType mask )
+			{
+				return ( hash ^ ( hash >> ( sizeof( SizeType ) * 4 ) ) ) & mask;
+			}
+
+			// The slot with key, or the empty slot where it would go.
+			Slot* Probe( const Key& key, SizeType hash ) const
+			{
+				const auto mask = slots_.size() - 1;
+				auto index = SlotOf( hash, mask );
+				while( true )
+				{
+					const auto& slot = slots_[index];
+					if( slot.id == npos || ( slot.hash == hash && equal_( keys_[slot.id], key ) ) )
+					{
+						return const_cast<Slot*>( &slot );
+					}
+					index = ( index + 1 ) & mask;
+				}
+			}
+
+			void Grow()
+			{
+				::std::vector<Slot> slots( slots_.size() * 2 );
+				const auto mask = slots.size() - 1;
+				for( const auto& slot : slots_ )
+				{
+					if( slot.id == npos )
+					{
+						continue;
+					}
+					auto index = SlotOf( slot.hash, mask );
+					while( slots[index].id != npos )
+					{
+						index = ( index + 1 ) & mask;
+					}
+					slots[index] = slot;
+				}
+				slots_.swap( slots );
+			}
+
+			Hash hash_;
+			KeyEqual equal_;
+			::std::vector<Slot> slots_;
+			::std::vector<Key> keys_;
+		};
+
+		template<typename Key, typename Hash, typename KeyEqual>
+		const typename FlatHashSet<Key, Hash, KeyEqual>::SizeType FlatHashSet<Key, Hash, KeyEqual>::npos;
+
+	}
+
+#pragma endregion
+
+#pragma region File
+
+	namespace Details {
+
+#if ( defined( _WIN32 ) && !defined( __cplusplus_winrt ) ) || defined( __unix__ ) || defined( __APPLE__ )
+#define LINQ_HAS_MAPPED_FILE
+
+		// A read-only mapping of a whole file, released when the last owner lets it go.
+		// The pages are hinted for sequential access, which makes the kernel read ahead aggressively during scans.
+		class MappedFile
+		{
+		public:
+			explicit MappedFile( const ::std::string& path )
+				: data_( nullptr )
+				, size_( 0 )
+			{
+#ifdef _WIN32
+				const auto file = ::CreateFileA( path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr );
+				if( file == INVALID_HANDLE_VALUE )
+				{
+					throw ::std::system_error( static_cast<int>( ::GetLastError() ), ::std::system_category(), path );
+				}
+
+				LARGE_INTEGER size;
+				if( !::GetFileSizeEx( file, &size ) )
+				{
+					const auto error = ::GetLastError();
+					::CloseHandle( file );
+					throw ::std::system_error( static_cast<int>( error ), ::std::system_category(), path );
+				}
+				size_ = static_cast<::std::size_t>( size.QuadPart );
+
+				if( size_ != 0 )
+				{
+					const auto mapping = ::CreateFileMappingA( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+					data_ = mapping != nullptr ? ::MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 ) : nullptr;
+					const auto error = ::GetLastError();
+					if( mapping != nullptr )
+					{
+						::CloseHandle( mapping );
+					}
+					if( data_ == nullptr )
+					{
+						::CloseHandle( file );
+						throw ::std::system_error( static_cast<int>( error ), ::std::system_category(), path );
+					}
+				}
+				::CloseHandle( file );
+#else
+				const auto file = ::open( path.c_str(), O_RDONLY | O_CLOEXEC );
+				if( file < 0 )
+				{
+					throw ::std::system_error( errno, ::std::generic_category(), path );
+				}
+
+				struct ::stat status;
+				if( ::fstat( file, &status ) != 0 )
+				{
+					const auto error = errno;
+					::close( file );
+					throw ::std::system_error( error, ::std::generic_category(), path );
+				}
+				size_ = static_cast<::std::size_t>( status.st_size );
+
+				if( size_ != 0 )
+				{
+					const auto data = ::mmap( nullptr, size_, PROT_READ, MAP_PRIVATE, file, 0 );
+					if( data == MAP_FAILED )
+					{
+						const auto error = errno;
+						::close( file );
+						throw ::std::system_error( error, ::std::generic_category(), path );
+					}
+					::madvise( data, size_, MADV_SEQUENTIAL );
+					data_ = data;
+				}
+				::close( file );
+#endif
+			}
+
+			MappedFile( const MappedFile& ) = delete;
+			MappedFile& operator=( const MappedFile& ) = delete;
+
+			~MappedFile()
+			{
+				if( data_ == nullptr )
+				{
+					return;
+				}
+#ifdef _WIN32
+				::UnmapViewOfFile( data_ );
+#else
+				::munmap( data_, size_ );
+#endif
+			}
+
+			const unsigned char* Data() const { return static_cast<const unsigned char*>( data_ ); }
+			::std::size_t Size() const { return size_; }
+
+		private:
+			void* data_;
+			::std::size_t size_;
+		};
+
+#endif
+
+		// The header of a snapshot written by Vectorable::to_file. The elements follow it in native byte order;
+		// the header is 64 bytes, so they stay aligned in a mapping.
+		struct SnapshotHeader
+		{
+			char magic[8];
+			::std::uint32_t version;
+			::std::uint32_t elementSize;
+			::std::uint64_t count;
+			::std::uint64_t checksum;
+			unsigned char reserved[32];
+		};
+		static_assert( sizeof( SnapshotHeader ) == 64, "SnapshotHeader must be 64 bytes." );
+
+		const char SnapshotMagic[8] = { 'L', 'I', 'N', 'Q', 'S', 'N', 'A', 'P' };
+		const ::std::uint32_t SnapshotVersion = 1;
+
+		// FNV-1a over 64-bit words with the high half folded back after each step, then the byte count.
+		// It is only meant to detect truncated or corrupted files.
+		inline ::std::uint64_t Checksum( const void* data, ::std::size_t size )
+		{
+			const auto bytes = static_cast<const unsigned char*>( data );
+			const ::std::uint64_t prime = 0x100000001b3ull;
+			::std::uint64_t hash = 0xcbf29ce484222325ull;
+			::std::size_t i = 0;
+			for( ; i + 8 <= size; i += 8 )
+			{
+				::std::uint64_t word;
+				::std::memcpy( &word, bytes + i, 8 );
+				hash = ( hash ^ word ) * prime;
+				hash ^= hash >> 32;
+			}
+			if( i < size )
+			{
+				::std::uint64_t word = 0;
+				::std::memcpy( &word, bytes + i, size - i );
+				hash = ( hash ^ word ) * prime;
+				hash ^= hash >> 32;
+			}
+			return ( hash ^ static_cast<::std::uint64_t>( size ) ) * prime;
+		}
+
+	}
+
+#pragma endregion
+
+#pragma region Enumerator
+
+	// Enumerators are the pull-based stages of the deferred execution pipeline.
+	// Each one exposes "ValueType", "bool MoveNext()" and "Current()", like .NET IEnumerator.
+	// MoveNext must not be called again once it has returned false.
+	// Most of them also have a push-based "void ForEach( Sink& sink )", which calls sink( value ) for every element until sink returns false,
+	// on an enumerator which has not been moved yet. The stages are then nested lambdas around one loop over the source,
+	// which the compiler inlines into a single fused loop; see Details::ForEach.
+	namespace Details {
+
+		// Calls sink( value ) and tells whether to go on. A sink which returns void never stops, so the check folds away.
+		template<typename Sink, typename V>
+		constexpr bool Push( Sink& sink, V&& value, ::std::true_type )
+		{
+			sink( ::std::forward<V>( value ) );
+			return true;
+		}
+		template<typename Sink, typename V>
+		constexpr bool Push( Sink& sink, V&& value, ::std::false_type )
+		{
+			return static_cast<bool>( sink( ::std::forward<V>( value ) ) );
+		}
+		template<typename Sink, typename V>
+		constexpr bool Push( Sink& sink, V&& value )
+		{
+			return Push( sink, ::std::forward<V>( value ), ::std::is_void<decltype( sink( ::std::forward<V>( value ) ) )>() );
+		}
+
+		template<typename Enumerator, typename Sink, typename = void>
+		struct HasForEach
+			: ::std::false_type
+		{ };
+
+		template<typename Enumerator, typename Sink>
+		struct HasForEach<Enumerator, Sink, typename MakeVoid<decltype( ::std::declval<Enumerator&>().ForEach( ::std::declval<Sink&>() ) )>::type>
+			: ::std::true_type
+		{ };
+
+		template<typename Enumerator, typename Sink>
+		constexpr void ForEach( Enumerator& enumerator, Sink& sink, ::std::true_type )
+		{
+			enumerator.ForEach( sink );
+		}
+		template<typename Enumerator, typename Sink>
+		constexpr void ForEach( Enumerator& enumerator, Sink& sink, ::std::false_type )
+		{
+			while( enumerator.MoveNext() )
+			{
+				if( !Push( sink, enumerator.Current() ) )
+				{
+					break;
+				}
+			}
+		}
+
+		// Pushes the elements of a fresh enumerator into sink, through its ForEach when it has one and MoveNext/Current otherwise.
+		template<typename Enumerator, typename Sink>
+		constexpr void ForEach( Enumerator& enumerator, Sink&& sink )
+		{
+			ForEach( enumerator, sink, HasForEach<Enumerator, ::std::remove_reference_t<Sink>>() );
+		}
+
+		template<typename FwdItr>
+		class IteratorEnumerator
+		{
+		public:
+			using ValueType = ::std::decay_t<decltype( Unwrap( *::std::declval<FwdItr>() ) )>;
+
+			constexpr IteratorEnumerator( FwdItr begin, FwdItr end )
+				: current_( begin )
+				, end_( end )
+				, started_( false )
+			{ }
+
+			constexpr bool MoveNext()
+			{
+				if( started_ )
+				{
+					++current_;
+				}
+				else
+				{
+					started_ = true;
+				}
+				return current_ != end_;
+			}
+
+			constexpr decltype( auto ) Current() const { return Unwrap( *current_ ); }
+
+			template<typename Sink>
+			constexpr void ForEach( Sink& sink )
+			{
+				for( ; current_ != end_; ++current_ )
+				{
+					if( !Push( sink, Unwrap( *current_ ) ) )
+					{
+						break;
+					}
+				}
+			}
+
+		private:
+			FwdItr current_, end_;
+			bool started_;
+		};
+
+		// Enumerates [first, last) of contiguous memory; "owner" keeps that memory alive when it is not borrowed.
+		template<typename V>
+		class PointerEnumerator
+		{
+		public:
+			using ValueType = typename IteratorEnumerator<const V*>::ValueType;
+
+			PointerEnumerator( const V* first, const V* last, ::std::shared_ptr<const void> owner )
+				: enumerator_( first, last )
+				, owner_( ::std::move( owner ) )
+			{ }
+
+			constexpr bool MoveNext() { return enumerator_.MoveNext(); }
+			constexpr decltype( auto ) Current() const { return enumerator_.Current(); }
+
+			template<typename Sink> constexpr void ForEach( Sink& sink ) { enumerator_.ForEach( sink ); }
+
+		private:
+			IteratorEnumerator<const V*> enumerator_;
+			::std::shared_ptr<const void> owner_;
+		};
+
+		// Reads a stream in blocks of up to blockSize elements with reader( stream, value ), which returns false at the end,
+		// so only one block is held in memory. The stream is consumed as the elements are pulled,
+		// which means a streaming sequence can be enumerated only once.
+		template<typename T, typename Reader>
+		class StreamEnumerator
+		{
+		public:
+			using ValueType = T;
+
+			StreamEnumerator( ::std::istream& stream, ::std::size_t blockSize, Reader reader )
+				: stream_( &stream )
+				, blockSize_( ::std::max( blockSize, static_cast<::std::size_t>( 1 ) ) )
+				, reader_( ::std::move( reader ) )
+				, index_( 0 )
+			{ }
+
+			constexpr bool MoveNext()
+			{
+				if( ++index_ < block_.size() )
+				{
+					return true;
+				}
+
+				block_.clear();
+				index_ = 0;
+				T value;
+				while( block_.size() < blockSize_ && reader_( *stream_, value ) )
+				{
+					block_.push_back( ::std::move( value ) );
+				}
+				return !block_.empty();
+			}
+
+			constexpr const T& Current() const { return block_[index_]; }
+
+		private:
+			::std::istream* stream_;
+			::std::size_t blockSize_;
+			Reader reader_;
+			::std::vector<T> block_;
+			::std::size_t index_;
+		};
+
+		// Only the end of the stream ends the elements; a token which operator>> cannot parse throws, instead of cutting them short.
+		struct ExtractReader
+		{
+			template<typename T>
+			bool operator()( ::std::istream& stream, T& value ) const
+			{
+				if( ( stream >> ::std::ws ).eof() )
+				{
+					return false;
+				}
+				if( !( stream >> value ) )
+				{
+					throw ::std::runtime_error( "FromStream: cannot parse an element." );
+				}
+				return true;
+			}
+		};
+
+		struct LineReader
+		{
+			bool operator()( ::std::istream& stream, ::std::string& line ) const { return static_cast<bool>( ::std::getline( stream, line ) ); }
+		};
+
+		// The generators compute their elements as they are pulled, in O( 1 ) memory.
+		// count integers from first; the offsets are added in unsigned arithmetic, so a range may end at the maximum of Integer.
+		template<typename Integer>
+		class RangeEnumerator
+		{
+		public:
+			using ValueType = Integer;
+
+			constexpr RangeEnumerator( Integer first, ::std::size_t count )
+				: first_( first )
+				, count_( count )
+				, index_( 0 )
+			{ }
+
+			constexpr bool MoveNext() { return index_++ < count_; }
+			constexpr Integer Current() const { return ElementAt( index_ - 1 ); }
+
+			template<typename Sink>
+			constexpr void ForEach( Sink& sink )
+			{
+				for( ; index_ < count_; ++index_ )
+				{
+					if( !Push( sink, ElementAt( index_ ) ) )
+					{
+						break;
+					}
+				}
+			}
+
+			constexpr ::std::size_t Count() const { return count_; }
+
+			constexpr Integer ElementAt( ::std::size_t index ) const
+			{
+				return static_cast<Integer>( static_cast<UnsignedType>( first_ ) + static_cast<UnsignedType>( index ) );
+			}
+
+			// count * first + count * ( count - 1 ) / 2, wrapping around like the loop would.
+			constexpr Integer Sum() const
+			{
+				using WideType = ::std::common_type_t<UnsignedType, unsigned int>;
+				const auto triangle = count_ % 2 == 0 ? count_ / 2 * ( count_ - 1 ) : ( count_ - 1 ) / 2 * count_;
+				return static_cast<Integer>( static_cast<WideType>( count_ ) * static_cast<WideType>( static_cast<UnsignedType>( first_ ) ) + static_cast<WideType>( triangle ) );
+			}
+
+			// The midpoint of the range, which does not overflow when Sum() does.
+			constexpr Integer Average() const
+			{
+				return static_cast<Integer>( static_cast<long double>( first_ ) + static_cast<long double>( count_ - 1 ) / 2 );
+			}
+
+			constexpr bool Contain( Integer value ) const
+			{
+				return count_ != 0 && first_ <= value && value <= ElementAt( count_ - 1 );
+			}
+
+			constexpr RangeEnumerator Skip( ::std::size_t count ) const
+			{
+				count = ::std::min( count, count_ );
+				return RangeEnumerator( ElementAt( count ), count_ - count );
+			}
+			constexpr RangeEnumerator Take( ::std::size_t count ) const { return RangeEnumerator( first_, ::std::min( count, count_ ) ); }
+
+		private:
+			using UnsignedType = ::std::make_unsigned_t<Integer>;
+
+			Integer first_;
+			::std::size_t count_;
+			::std::size_t index_;
+		};
+
+		template<typename T>
+		class RepeatEnumerator
+		{
+		public:
+			using ValueType = T;
+
+			constexpr RepeatEnumerator( T element, ::std::size_t count )
+				: element_( ::std::move( element ) )
+				, count_( count )
+				, index_( 0 )
+			{ }
+
+			constexpr bool MoveNext() { return index_++ < count_; }
+			constexpr const T& Current() const { return element_; }
+
+			template<typename Sink>
+			constexpr void ForEach( Sink& sink )
+			{
+				for( ; index_ < count_; ++index_ )
+				{
+					if( !Push( sink, static_cast<const T&>( element_ ) ) )
+					{
+						break;
+					}
+				}
+			}
+
+			constexpr ::std::size_t Count() const { return count_; }
+			constexpr const T& ElementAt( ::std::size_t ) const { return element_; }
+			constexpr T Sum() const { return Sum( ::std::is_integral<T>() ); }
+			constexpr T Average() const { return element_; }
+			constexpr bool Contain( const T& value ) const { return count_ != 0 && element_ == value; }
+			constexpr RepeatEnumerator Skip( ::std::size_t count ) const { return RepeatEnumerator( element_, count_ - ::std::min( count, count_ ) ); }
+			constexpr RepeatEnumerator Take( ::std::size_t count ) const { return RepeatEnumerator( element_, ::std::min( count, count_ ) ); }
+
+		private:
+			// element * count, wrapping around for integers and in double for floating point, like the loop would.
+			constexpr T Sum( ::std::true_type ) const
+			{
+				using WideType = ::std::common_type_t<::std::make_unsigned_t<T>, unsigned int>;
+				return static_cast<T>( static_cast<WideType>( static_cast<::std::make_unsigned_t<T>>( element_ ) ) * static_cast<WideType>( count_ ) );
+			}
+			constexpr T Sum( ::std::false_type ) const
+			{
+				return static_cast<T>( static_cast<::std::common_type_t<T, double>>( element_ ) * static_cast<double>( count_ ) );
+			}
+
+			T element_;
+			::std::size_t count_;
+			::std::size_t index_;
+		};
+
+		// seed, step( seed ), step( step( seed ) ), ... without end. step is only called for the elements which are pulled.
+		template<typename T, typename Step>
+		class IterateEnumerator
+		{
+		public:
+			using ValueType = T;
+
+			constexpr IterateEnumerator( T seed, Step step )
+				: current_( ::std::move( seed ) )
+				, step_( ::std::move( step ) )
+				, started_( false )
+			{ }
+
+			constexpr bool MoveNext()
+			{
+				if( started_ )
+				{
+					current_ = step_( current_ );
+				}
+				started_ = true;
+				return true;
+			}
+
+			constexpr const T& Current() const { return current_; }
+
+			template<typename Sink>
+			constexpr void ForEach( Sink& sink )
+			{
+				while( Push( sink, static_cast<const T&>( current_ ) ) )
+				{
+					current_ = step_( current_ );
+				}
+			}
+
+		private:
+			T current_;
+			Step step_;
+			bool started_;
+		};
+
+		// Range and Repeat have a closed form. A fresh one holds its elements in ascending order and answers Count(), ElementAt( index ),
+		// Sum(), Average(), Contain( value ), Skip( count ) and Take( count ) in O( 1 ), so Enumerable does not enumerate it for those.
+		template<typename Enumerator>
+		struct HasClosedForm
+			: ::std::false_type
+		{ };
+
+		template<typename Integer>
+		struct HasClosedForm<RangeEnumerator<Integer>>
+			: ::std::true_type
+		{ };
+
+		template<typename T>
+		struct HasClosedForm<RepeatEnumerator<T>>
+			: ::std::true_type
+		{ };
+
+		// func(), func(), ... without end.
+		template<typename T, typename Func>
+		class GenerateEnumerator
+		{
+		public:
+			using ValueType = T;
+
+			constexpr GenerateEnumerator( Func func )
+				: func_( ::std::move( func ) )
+				, current_()
+			{ }
+
+			constexpr bool MoveNext()
+			{
+				current_ = func_();
+				return true;
+			}
+
+			constexpr const T& Current() const { return current_; }
+
+			template<typename Sink>
+			constexpr void ForEach( Sink& sink )
+			{
+				while( Push( sink, func_() ) )
+				{
+				}
+			}
+
+		private:
+			Func func_;
+			T current_;
+		};
+
+		template<typename Source, typename Predicate>
+		class WhereEnumerator
+		{
+		public:
+			using ValueType = typename Source::ValueType;
+
+			constexpr WhereEnumerator( Source source, Predicate predicate )
+				: source_( ::std::move( source ) )
+				, predicate_( ::std::move( predicate ) )
+			{ }
+
+			constexpr bool MoveNext()
+			{
+				while( source_.MoveNext() )
+				{
+					if( predicate_( source_.Current() ) )
+					{
+						return true;
+					}
+				}
+				return false;
+			}
+
+			constexpr decltype( auto ) Current() const { return source_.Current(); }
+
+			template<typename Sink>
+			constexpr void ForEach( Sink& sink )
+			{
+				auto& predicate = predicate_;
+				Details::ForEach( source_, [&predicate, &sink]( auto&& value ) { return !predicate( value ) || Push( sink, value ); } );
+			}
+
+		private:
+			Source source_;
+			Predicate predicate_;
+		};
+
+		template<typename S, typename Source, typename Selector>
+		class SelectEnumerator
+		{
+		public:
+			using ValueType = S;
+
+			constexpr SelectEnumerator( Source source, Selector selector )
+				: source_( ::std::move( source ) )
+				, selector_( ::std::move( selector ) )
+				, current_()
+			{ }
+
+			constexpr bool MoveNext()
+			{
+				if( !source_.MoveNext() )
+				{
+					return false;
+				}
+
+				current_ = selector_( source_.Current() );
+				return true;
+			}
+
+			constexpr const S& Current() const { return current_; }
+
+			template<typename Sink>
+			constexpr void ForEach( Sink& sink )
+			{
+				auto& selector = selector_;
+				Details::ForEach( source_, [&selector, &sink]( auto&& value ) { return Push( sink, static_cast<S>( selector( value ) ) ); } );
+			}
+
+		private:
+			Source source_;
+			Selector selector_;
+			S current_;
+		};
+
+		template<typename Source>
+		class SkipEnumerator
+		{
+		public:
+			using ValueType = typename Source::ValueType;
+
+			constexpr SkipEnumerator( Source source, ::std::size_t count )
+				: source_( ::std::move( source ) )
+				, count_( count )
+			{ }
+
+			constexpr bool MoveNext()
+			{
+				for( ; count_ != 0; --count_ )
+				{
+					if( !source_.MoveNext() )
+					{
+						return false;
+					}
+				}
+				return source_.MoveNext();
+			}
+
+			constexpr decltype( auto ) Current() const { return source_.Current(); }
+
+			template<typename Sink>
+			constexpr void ForEach( Sink& sink )
+			{
+				auto& count = count_;
+				Details::ForEach( source_, [&count, &sink]( auto&& value )
+				{
+					if( count != 0 )
+					{
+						--count;
+						return true;
+					}
+					return Push( sink, value );
+				} );
+			}
+
+		private:
+			Source source_;
+			::std::size_t count_;
+		};
+
+		template<typename Source, typename Predicate>
+		class SkipWhileEnumerator
+		{
+		public:
+			using ValueType = typename Source::ValueType;
+
+			constexpr SkipWhileEnumerator( Source source, Predicate predicate )
+				: source_( ::std::move( source ) )
+				, predicate_( ::std::move( predicate ) )
+				, skipping_( true )
+			{ }
+
+			constexpr bool MoveNext()
+			{
+				if( !skipping_ )
+				{
+					return source_.MoveNext();
+				}
+
+				skipping_ = false;
+				while( source_.MoveNext() )
+				{
+					if( !predicate_( source_.Current() ) )
+					{
+						return true;
+					}
+				}
+				return false;
+			}
+
+			constexpr decltype( auto ) Current() const { return source_.Current(); }
+
+			template<typename Sink>
+			constexpr void ForEach( Sink& sink )
+			{
+				auto& predicate = predicate_;
+				auto& skipping = skipping_;
+				Details::ForEach( source_, [&predicate, &skipping, &sink]( auto&& value )
+				{
+					if( skipping && predicate( value ) )
+					{
+						return true;
+					}
+					skipping = false;
+					return Push( sink, value );
+				} );
+			}
+
+		private:
+			Source source_;
+			Predicate predicate_;
+			bool skipping_;
+		};
+
+		template<typename Source>
+		class TakeEnumerator
+		{
+		public:
+			using ValueType = typename Source::ValueType;
+
+			constexpr TakeEnumerator( Source source, ::std::size_t count )
+				: source_( ::std::move( source ) )
+				, count_( count )
+			{ }
+
+			constexpr bool MoveNext()
+			{
+				if( count_ == 0 )
+				{
+					return false;
+				}
+
+				--count_;
+				return source_.MoveNext();
+			}
+
+			constexpr decltype( auto ) Current() const { return source_.Current(); }
+
+			template<typename Sink>
+			constexpr void ForEach( Sink& sink )
+			{
+				if( count_ == 0 )
+				{
+					return;
+				}
+
+				auto& count = count_;
+				Details::ForEach( source_, [&count, &sink]( auto&& value ) { return Push( sink, value ) && --count != 0; } );
+			}
+
+		private:
+			Source source_;
+			::std::size_t count_;
+		};
+
+		template<typename Source, typename Predicate>
+		class TakeWhileEnumerator
+		{
+		public:
+			using ValueType = typename Source::ValueType;
+
+			constexpr TakeWhileEnumerator( Source source, Predicate predicate )
+				: source_( ::std::move( source ) )
+				, predicate_( ::std::move( predicate ) )
+				, done_( false )
+			{ }
+
+			constexpr bool MoveNext()
+			{
+				if( done_ )
+				{
+					return false;
+				}
+
+				if( source_.MoveNext() && predicate_( source_.Current() ) )
+				{
+					return true;
+				}
+
+				done_ = true;
+				return false;
+			}
+
+			constexpr decltype( auto ) Current() const { return source_.Current(); }
+
+			template<typename Sink>
+			constexpr void ForEach( Sink& sink )
+			{
+				if( done_ )
+				{
+					return;
+				}
+
+				auto& predicate = predicate_;
+				auto& done = done_;
+				Details::ForEach( source_, [&predicate, &done, &sink]( auto&& value )
+				{
+					if( !predicate( value ) )
+					{
+						done = true;
+						return false;
+					}
+					return Push( sink, value );
+				} );
+			}
+
+		private:
+			Source source_;
+			Predicate predicate_;
+			bool done_;
+		};
+
+	}
+
+	template<typename T, typename Enumerator> class Enumerable;
+
+#pragma endregion
+
+#pragma region Parallel
+
+	namespace Details {
+
+		// Work-stealing thread pool: every worker owns a deque, pops its own tasks from the back
+		// and steals from the front of the others when it runs dry.
+		class ThreadPool
+		{
+		public:
+			explicit ThreadPool( ::std::size_t threadCount )
+				: queues_( threadCount )
+				, pending_( 0 )
+				, next_( 0 )
+				, stopping_( false )
+			{
+				threads_.reserve( threadCount );
+				for( ::std::size_t i = 0; i < threadCount; ++i )
+				{
+					threads_.emplace_back( [this, i] { WorkerLoop( i ); } );
+				}
+			}
+
+			ThreadPool( const ThreadPool& ) = delete;
+			ThreadPool& operator=( const ThreadPool& ) = delete;
+
+			~ThreadPool()
+			{
+				{
+					::std::lock_guard<::std::mutex> lock( mutex_ );
+					stopping_ = true;
+				}
+				wake_.notify_all();
+
+				for( auto&& thread : threads_ )
+				{
+					thread.join();
+				}
+			}
+
+			static ThreadPool& Default()
+			{
+				static ThreadPool pool( ::std::max( ::std::thread::hardware_concurrency(), 1u ) );
+				return pool;
+			}
+
+			inline ::std::size_t ThreadCount() const { return threads_.size(); }
+
+			inline void Submit( ::std::function<void()> task )
+			{
+				// Workers push to their own deque; other threads spread tasks round-robin.
+				const auto index = CurrentWorker().first == this
+					? CurrentWorker().second
+					: next_.fetch_add( 1, ::std::memory_order_relaxed ) % queues_.size();
+				{
+					::std::lock_guard<::std::mutex> lock( queues_[index].mutex );
+					queues_[index].tasks.push_back( ::std::move( task ) );
+				}
+				{
+					::std::lock_guard<::std::mutex> lock( mutex_ );
+					++pending_;
+				}
+				wake_.notify_one();
+			}
+
+			// Runs one queued task on the calling thread. Lets a waiting thread help instead of blocking.
+			inline bool TryRunOne()
+			{
+				::std::function<void()> task;
+				const auto index = CurrentWorker().first == this ? CurrentWorker().second : 0;
+				if( !TryPop( index, task ) )
+				{
+					return false;
+				}
+
+				task();
+				return true;
+			}
+
+		private:
+			struct Queue
+			{
+				::std::mutex mutex;
+				::std::deque<::std::function<void()>> tasks;
+			};
+
+			static ::std::pair<const ThreadPool*, ::std::size_t>& CurrentWorker()
+			{
+				static thread_local ::std::pair<const ThreadPool*, ::std::size_t> worker( nullptr, 0 );
+				return worker;
+			}
+
+			inline bool TryPop( ::std::size_t index, ::std::function<void()>& task )
+			{
+				bool found = false;
+				{
+					auto& own = queues_[index];
+					::std::lock_guard<::std::mutex> lock( own.mutex );
+					if( !own.tasks.empty() )
+					{
+						task = ::std::move( own.tasks.back() );
+						own.tasks.pop_back();
+						found = true;
+					}
+				}
+
+				for( ::std::size_t i = 1; !found && i < queues_.size(); ++i )
+				{
+					auto& victim = queues_[( index + i ) % queues_.size()];
+					::std::lock_guard<::std::mutex> lock( victim.mutex );
+					if( !victim.tasks.empty() )
+					{
+						task = ::std::move( victim.tasks.front() );
+						victim.tasks.pop_front();
+						found = true;
+					}
+				}
+
+				if( found )
+				{
+					::std::lock_guard<::std::mutex> lock( mutex_ );
+					--pending_;
+				}
+				return found;
+			}
+
+			inline void WorkerLoop( ::std::size_t index )
+			{
+				CurrentWorker() = ::std::make_pair( this, index );
+
+				for( ;; )
+				{
+					::std::function<void()> task;
+					if( TryPop( index, task ) )
+					{
+						task();
+						continue;
+					}
+
+					::std::unique_lock<::std::mutex> lock( mutex_ );
+					wake_.wait( lock, [this] { return stopping_ || pending_ != 0; } );
+					if( stopping_ && pending_ == 0 )
+					{
+						return;
+					}
+				}
+			}
+
+			::std::vector<Queue> queues_;
+			::std::vector<::std::thread> threads_;
+			::std::mutex mutex_;
+			::std::condition_variable wake_;
+			::std::size_t pending_;
+			::std::atomic<::std::size_t> next_;
+			bool stopping_;
+		};
+
+		// Splits [0, count) into chunkCount chunks and runs body( begin, end, chunkIndex ) for each of them.
+		// degree - 1 pool tasks and the calling thread pull chunks from a shared counter, so at most degree chunks run at once.
+		// The first exception thrown by body is rethrown on the calling thread.
+		template<typename Body>
+		inline void ParallelFor( ThreadPool& pool, ::std::size_t count, ::std::size_t chunkCount, ::std::size_t degree, Body body )
+		{
+			// running and error are only touched under mutex, so the caller cannot see the last task finish and return
+			// while that task is still using these locals.
+			::std::atomic<::std::size_t> nextChunk( 0 );
+			::std::size_t running = degree;
+			::std::mutex mutex;
+			::std::condition_variable done;
+			::std::exception_ptr error;
+
+			const auto run = [&]
+			{
+				for( auto chunk = nextChunk++; chunk < chunkCount; chunk = nextChunk++ )
+				{
+					try
+					{
+						body( count * chunk / chunkCount, count * ( chunk + 1 ) / chunkCount, chunk );
+					}
+					catch( ... )
+					{
+						::std::lock_guard<::std::mutex> lock( mutex );
+						if( !error )
+						{
+							error = ::std::current_exception();
+						}
+					}
+				}
+
+				::std::lock_guard<::std::mutex> lock( mutex );
+				if( --running == 0 )
+				{
+					done.notify_all();
+				}
+			};
+
+			for( ::std::size_t i = 1; i < degree; ++i )
+			{
+				pool.Submit( run );
+			}
+			run();
+
+			// Every task was submitted before this point, so when nothing is left to help with, they are all running.
+			::std::unique_lock<::std::mutex> lock( mutex );
+			while( running != 0 )
+			{
+				lock.unlock();
+				const auto ran = pool.TryRunOne();
+				lock.lock();
+				if( !ran )
+				{
+					done.wait( lock, [&running] { return running == 0; } );
+				}
+			}
+
+			if( error )
+			{
+				::std::rethrow_exception( error );
+			}
+		}
+
+	}
+
+	// The order a Vectorable is known to be in. OrderBy and OrderByDescending set it (OrderBy( predicate ) only for ::std::less
+	// and ::std::greater), the operators which keep a subsequence (Where, Skip*, Take*, Distinct, ...) preserve it, Reverse flips it,
+	// and the others, as well as Begin and End, forget it.
+	enum class Ordering { None, Ascending, Descending };
+
+	namespace Details {
+
+		// The Ordering that sorting elements of type V with Predicate gives. Only ::std::less / ::std::greater of V itself or of void
+		// compare with the operator< of V; ::std::less<int> on doubles, for example, does not sort them by their value.
+		template<typename Predicate, typename V>
+		struct OrderingOf
+			: ::std::integral_constant<Ordering, Ordering::None>
+		{ };
+
+		template<typename V>
+		struct OrderingOf<::std::less<V>, V>
+			: ::std::integral_constant<Ordering, Ordering::Ascending>
+		{ };
+
+		template<typename V>
+		struct OrderingOf<::std::less<>, V>
+			: ::std::integral_constant<Ordering, Ordering::Ascending>
+		{ };
+
+		template<typename V>
+		struct OrderingOf<::std::greater<V>, V>
+			: ::std::integral_constant<Ordering, Ordering::Descending>
+		{ };
+
+		template<typename V>
+		struct OrderingOf<::std::greater<>, V>
+			: ::std::integral_constant<Ordering, Ordering::Descending>
+		{ };
+
+		// lower_bound of value in the sorted [first, last), probing first + 1, 2, 4, ... before the binary search,
+		// so that it costs O( log( distance to the result ) ) rather than O( log( last - first ) ).
+		template<typename RndItr, typename V, typename Compare>
+		constexpr RndItr Gallop( RndItr first, RndItr last, const V& value, Compare comp )
+		{
+			const auto size = last - first;
+			decltype( last - first ) bound = 1;
+			while( bound < size && comp( first[bound], value ) )
+			{
+				bound *= 2;
+			}
+			return ::std::lower_bound( first + bound / 2, first + ::std::min( bound + 1, size ), value, comp );
+		}
+
+		// An unsigned integer of the same size as T, which is in the same order as the values: the sign bit of signed integers is flipped,
+		// and so are all the bits of negative IEEE floating point values (only the sign bit of the others).
+		template<typename T, typename = void>
+		struct RadixKey;
+
+		template<typename T>
+		struct RadixKey<T, ::std::enable_if_t<::std::is_integral<T>::value && !::std::is_same<T, bool>::value>>
+		{
+			using type = ::std::make_unsigned_t<T>;
+
+			static constexpr type Get( T value )
+			{
+				return static_cast<type>( static_cast<type>( value ) ^ ( ::std::is_signed<T>::value ? static_cast<type>( type( 1 ) << ( sizeof( T ) * 8 - 1 ) ) : type( 0 ) ) );
+			}
+		};
+
+		template<typename T>
+		struct RadixKey<T, ::std::enable_if_t<::std::is_floating_point<T>::value && ::std::numeric_limits<T>::is_iec559 && ( sizeof( T ) == 4 || sizeof( T ) == 8 )>>
+		{
+			using type = ::std::conditional_t<sizeof( T ) == 4, ::std::uint32_t, ::std::uint64_t>;
+
+			static type Get( T value )
+			{
+				type bits;
+				::std::memcpy( &bits, &value, sizeof( bits ) );
+				const auto sign = static_cast<type>( type( 1 ) << ( sizeof( T ) * 8 - 1 ) );
+				return ( bits & sign ) != 0 ? static_cast<type>( ~bits ) : static_cast<type>( bits | sign );
+			}
+		};
+
+		template<typename T, typename = void>
+		struct HasRadixKey
+			: ::std::false_type
+		{ };
+
+		template<typename T>
+		struct HasRadixKey<T, typename MakeVoid<typename RadixKey<T>::type>::type>
+			: ::std::true_type
+		{ };
+
+		// Below this many elements ::std::sort is faster than the radix passes and their buffer.
+		constexpr ::std::size_t RadixSortThreshold = 2048;
+
+		// Stable LSD radix sort of [first, last) by key( element ), an unsigned integer, one byte per pass.
+		// The histograms of all the bytes are counted in one pass, and the passes whose byte is the same for every element are skipped.
+		template<typename V, typename Key>
+		void RadixSort( V* first, V* last, Key key )
+		{
+			using KeyType = ::std::decay_t<decltype( key( *first ) )>;
+			constexpr ::std::size_t digits = sizeof( KeyType );
+			const auto count = static_cast<::std::size_t>( last - first );
+			if( count < 2 )
+			{
+				return;
+			}
+
+			::std::size_t histograms[digits][256] = { };
+			for( auto itr = first; itr != last; ++itr )
+			{
+				const auto k = key( *itr );
+				for( ::std::size_t digit = 0; digit < digits; ++digit )
+				{
+					++histograms[digit][( k >> ( digit * 8 ) ) & 0xFF];
+				}
+			}
+
+			::std::vector<V> buffer( count );
+			auto source = first;
+			auto target = buffer.data();
+			for( ::std::size_t digit = 0; digit < digits; ++digit )
+			{
+				auto& histogram = histograms[digit];
+				if( histogram[( key( *source ) >> ( digit * 8 ) ) & 0xFF] == count )
+				{
+					continue;
+				}
+
+				::std::size_t offset = 0;
+				for( auto& bucket : histogram )
+				{
+					const auto size = bucket;
+					bucket = offset;
+					offset += size;
+				}
+				for( ::std::size_t i = 0; i < count; ++i )
+				{
+					target[histogram[( key( source[i] ) >> ( digit * 8 ) ) & 0xFF]++] = ::std::move( source[i] );
+				}
+				::std::swap( source, target );
+			}
+			if( source != first )
+			{
+				::std::move( source, source + count, first );
+			}
+		}
+
+		template<typename Predicate, typename V, typename Compare>
+		void Sort( V* first, V* last, Compare comp, ::std::false_type )
+		{
+			::std::sort( first, last, comp );
+		}
+
+		template<typename Predicate, typename V, typename Compare>
+		void Sort( V* first, V* last, Compare comp, ::std::true_type )
+		{
+			using KeyType = typename RadixKey<V>::type;
+			if( static_cast<::std::size_t>( last - first ) < RadixSortThreshold )
+			{
+				::std::sort( first, last, comp );
+			}
+			else if( OrderingOf<Predicate, V>::value == Ordering::Ascending )
+			{
+				RadixSort( first, last, []( V value ) { return RadixKey<V>::Get( value ); } );
+			}
+			else
+			{
+				RadixSort( first, last, []( V value ) { return static_cast<KeyType>( ~RadixKey<V>::Get( value ) ); } );
+			}
+		}
+
+		// ::std::sort( first, last, comp ), unless sorting with Predicate gives an Ordering (::std::less and ::std::greater)
+		// of arithmetic values, which are radix sorted by RadixKey when there are enough of them.
+		template<typename Predicate, typename V, typename Compare>
+		void Sort( V* first, V* last, Compare comp )
+		{
+			Sort<Predicate>( first, last, comp, ::std::integral_constant<bool, OrderingOf<Predicate, V>::value != Ordering::None && HasRadixKey<V>::value>() );
+		}
+
+		// One key of OrderBy( keySelector ), ThenBy and so on: the selector, and the direction of the key.
+		template<typename KeySelector, bool Descending>
+		struct SortLevel
+		{
+			using SelectorType = KeySelector;
+
+			template<typename K>
+			static constexpr bool Less( const K& x, const K& y ) { return Descending ? y < x : x < y; }
+
+			template<typename K>
+			static typename RadixKey<K>::type Radix( const K& key )
+			{
+				return static_cast<typename RadixKey<K>::type>( Descending ? ~RadixKey<K>::Get( key ) : RadixKey<K>::Get( key ) );
+			}
+
+			KeySelector selector;
+		};
+
+		// The keys of one element for the levels of an OrderedVectorable, each computed once, and compared level by level.
+		template<typename T, typename... Levels>
+		struct SortKeys
+		{
+			SortKeys() = default;
+			constexpr SortKeys( const T& ) { }
+
+			static constexpr bool Less( const SortKeys&, const SortKeys& ) { return false; }
+		};
+
+		template<typename T, typename Level, typename... Levels>
+		struct SortKeys<T, Level, Levels...>
+		{
+			using KeyType = ::std::decay_t<InvokeResultT<const typename Level::SelectorType, const T&>>;
+
+			SortKeys() = default;
+			constexpr SortKeys( const T& value, const Level& level, const Levels&... levels )
+				: key( level.selector( value ) )
+				, next( value, levels... )
+			{ }
+
+			static constexpr bool Less( const SortKeys& x, const SortKeys& y )
+			{
+				return Level::Less( x.key, y.key ) || ( !Level::Less( y.key, x.key ) && SortKeys<T, Levels...>::Less( x.next, y.next ) );
+			}
+
+			KeyType key;
+			SortKeys<T, Levels...> next;
+		};
+
+		// One arithmetic key is radix sorted, by RadixSort (which is stable).
+		template<typename T, typename... Levels>
+		struct IsRadixSortable
+			: ::std::false_type
+		{ };
+
+		template<typename T, typename Level>
+		struct IsRadixSortable<T, Level>
+			: HasRadixKey<typename SortKeys<T, Level>::KeyType>
+		{ };
+
+		// Sorts the ( keys, index ) pairs stably by their keys.
+		template<typename Keys, typename SizeType>
+		void SortDecorated( ::std::pair<Keys, SizeType>* first, ::std::pair<Keys, SizeType>* last, ::std::false_type )
+		{
+			::std::stable_sort( first, last, []( const ::std::pair<Keys, SizeType>& x, const ::std::pair<Keys, SizeType>& y ) { return Keys::Less( x.first, y.first ); } );
+		}
+
+		template<typename T, typename Level, typename SizeType>
+		void SortDecorated( ::std::pair<SortKeys<T, Level>, SizeType>* first, ::std::pair<SortKeys<T, Level>, SizeType>* last, ::std::true_type )
+		{
+			if( static_cast<::std::size_t>( last - first ) < RadixSortThreshold )
+			{
+				SortDecorated( first, last, ::std::false_type() );
+			}
+			else
+			{
+				RadixSort( first, last, []( const ::std::pair<SortKeys<T, Level>, SizeType>& x ) { return Level::Radix( x.first.key ); } );
+			}
+		}
+
+	}
+
+	template<typename T, typename Allocator = ::std::allocator<typename Details::Wrap<T>::type>> class Vectorable;
+	template<typename T> class ParallelVectorable;
+	template<typename Key, typename Element, typename Hash, typename KeyEqual> class Lookup;
+	template<typename T, typename KeySelector, typename ElementSelector, typename Hash, typename KeyEqual> class GroupedVectorable;
+	template<typename T, typename Allocator, typename... Levels> class OrderedVectorable;
+
+#pragma endregion
+
+#pragma region Allocator
+
+	// A monotonic arena for the intermediate buffers of a query: Allocate bumps a pointer through blocks which grow geometrically,
+	// deallocation is a no-op, and all the memory is given back at once by Release or the destructor.
+	// Not thread safe; a query which uses it must not outlive it.
+	class Arena
+	{
+	public:
+		using SizeType = ::std::size_t;
+
+		explicit Arena( SizeType initialSize = 64 * 1024 )
+			: current_( nullptr )
+			, remaining_( 0 )
+			, nextSize_( initialSize != 0 ? initialSize : 1 )
+			, allocated_( 0 )
+		{ }
+
+		Arena( const Arena& ) = delete;
+		Arena& operator=( const Arena& ) = delete;
+
+		void* Allocate( SizeType size, SizeType alignment )
+		{
+			auto space = remaining_;
+			void* ptr = current_;
+			if( ptr == nullptr || ::std::align( alignment, size, ptr, space ) == nullptr )
+			{
+				const auto blockSize = ::std::max( nextSize_, size + alignment );
+				blocks_.emplace_back( new unsigned char[blockSize] );
+				nextSize_ = blockSize * 2;
+				ptr = blocks_.back().get();
+				space = blockSize;
+				::std::align( alignment, size, ptr, space );
+			}
+
+			current_ = static_cast<unsigned char*>( ptr ) + size;
+			remaining_ = space - size;
+			allocated_ += size;
+			return ptr;
+		}
+
+		// Frees every block. Everything allocated from this arena becomes invalid.
+		void Release()
+		{
+			blocks_.clear();
+			current_ = nullptr;
+			remaining_ = 0;
+			allocated_ = 0;
+		}
+
+		// The bytes handed out since the last Release, and the number of blocks taken from the heap for them.
+		SizeType Allocated() const { return allocated_; }
+		SizeType BlockCount() const { return blocks_.size(); }
+
+	private:
+		::std::vector<::std::unique_ptr<unsigned char[]>> blocks_;
+		unsigned char* current_;
+		SizeType remaining_;
+		SizeType nextSize_;
+		SizeType allocated_;
+	};
+
+	// A standard allocator on an Arena, e.g. Linq::From( vec, Linq::ArenaAllocator<int>( arena ) ).
+	template<typename T>
+	class ArenaAllocator
+	{
+		template<typename U> friend class ArenaAllocator;
+
+	public:
+		using value_type = T;
+
+		explicit ArenaAllocator( Arena& arena ) noexcept
+			: arena_( &arena )
+		{ }
+
+		template<typename U>
+		ArenaAllocator( const ArenaAllocator<U>& other ) noexcept
+			: arena_( other.arena_ )
+		{ }
+
+		T* allocate( ::std::size_t count ) { return static_cast<T*>( arena_->Allocate( count * sizeof( T ), alignof( T ) ) ); }
+		void deallocate( T*, ::std::size_t ) noexcept { }
+
+		template<typename U> bool operator==( const ArenaAllocator<U>& other ) const noexcept { return arena_ == other.arena_; }
+		template<typename U> bool operator!=( const ArenaAllocator<U>& other ) const noexcept { return arena_ != other.arena_; }
+
+	private:
+		Arena* arena_;
+	};
+
+#ifdef __cpp_lib_memory_resource
+	// With C++17 the standard memory resources work the same way, e.g. a ::std::pmr::monotonic_buffer_resource per query.
+	template<typename T>
+	using PmrVectorable = Vectorable<T, ::std::pmr::polymorphic_allocator<typename Details::Wrap<T>::type>>;
+#endif
+
+#pragma endregion
+
+#pragma region Instrumentation
+
+#ifdef LINQ_ENABLE_INSTRUMENTATION
+	// Opt-in with LINQ_ENABLE_INSTRUMENTATION: each instrumented operator call is recorded as an Event with its wall time,
+	// the elements in and out, the predicate / selector invocations, and the bytes of the buffer it allocated.
+	// Operators which call other operators record those too, nested in time. Without the macro nothing of this is compiled.
+	namespace Instrumentation {
+
+		struct Event
+		{
+			const char* name;
+			::std::uint32_t thread;
+			::std::int64_t start;
+			::std::int64_t duration;
+			::std::uint64_t elementsIn;
+			::std::uint64_t elementsOut;
+			::std::uint64_t invocations;
+			::std::uint64_t bytesAllocated;
+		};
+
+		// The totals of every Event with the same name.
+		struct OperatorStats
+		{
+			::std::string name;
+			::std::uint64_t calls;
+			::std::uint64_t elementsIn;
+			::std::uint64_t elementsOut;
+			::std::uint64_t invocations;
+			::std::uint64_t bytesAllocated;
+			::std::int64_t nanoseconds;
+		};
+
+		class Recorder
+		{
+		public:
+			using Clock = ::std::chrono::steady_clock;
+
+			Recorder()
+				: origin_( Clock::now() )
+			{ }
+
+			// Nanoseconds since the recorder was created.
+			::std::int64_t Now() const
+			{
+				return ::std::chrono::duration_cast<::std::chrono::nanoseconds>( Clock::now() - origin_ ).count();
+			}
+
+			void Record( const Event& event )
+			{
+				::std::lock_guard<::std::mutex> lock( mutex_ );
+				events_.push_back( event );
+			}
+
+			::std::vector<Event> Events() const
+			{
+				::std::lock_guard<::std::mutex> lock( mutex_ );
+				return events_;
+			}
+
+			// One entry per operator name, in the order of their first call.
+			::std::vector<OperatorStats> Stats() const
+			{
+				::std::vector<OperatorStats> ret;
+				for( const auto& event : Events() )
+				{
+					auto itr = ::std::find_if( ret.begin(), ret.end(), [&event]( const OperatorStats& stats ) { return stats.name == event.name; } );
+					if( itr == ret.end() )
+					{
+						ret.push_back( OperatorStats { event.name, 0, 0, 0, 0, 0, 0 } );
+						itr = ret.end() - 1;
+					}
+
+					++itr->calls;
+					itr->elementsIn += event.elementsIn;
+					itr->elementsOut += event.elementsOut;
+					itr->invocations += event.invocations;
+					itr->bytesAllocated += event.bytesAllocated;
+					itr->nanoseconds += event.duration;
+				}
+				return ret;
+			}
+
+			void Reset()
+			{
+				::std::lock_guard<::std::mutex> lock( mutex_ );
+				events_.clear();
+			}
+
+			// The Chrome trace-event format ("X" complete events in microseconds), for chrome://tracing or Perfetto.
+			void WriteChromeTrace( ::std::ostream& stream ) const
+			{
+				stream << "{\"traceEvents\":[";
+				bool first = true;
+				for( const auto& event : Events() )
+				{
+					stream << ( first ? "\n" : ",\n" )
+						<< "{\"name\":\"" << event.name << "\",\"cat\":\"linq\",\"ph\":\"X\",\"pid\":1"
+						<< ",\"tid\":" << event.thread
+						<< ",\"ts\":" << static_cast<double>( event.start ) / 1000.0
+						<< ",\"dur\":" << static_cast<double>( event.duration ) / 1000.0
+						<< ",\"args\":{\"elementsIn\":" << event.elementsIn
+						<< ",\"elementsOut\":" << event.elementsOut
+						<< ",\"invocations\":" << event.invocations
+						<< ",\"bytesAllocated\":" << event.bytesAllocated << "}}";
+					first = false;
+				}
+				stream << "\n],\"displayTimeUnit\":\"ns\"}\n";
+			}
+
+			static Recorder& Default()
+			{
+				static Recorder recorder;
+				return recorder;
+			}
+
+			// A small id per thread, in the order the threads first record something.
+			static ::std::uint32_t ThreadId()
+			{
+				static ::std::atomic<::std::uint32_t> next( 0 );
+				thread_local const auto id = next++;
+				return id;
+			}
+
+		private:
+			Clock::time_point origin_;
+			mutable ::std::mutex mutex_;
+			::std::vector<Event> events_;
+		};
+
+		inline ::std::vector<OperatorStats> Stats() { return Recorder::Default().Stats(); }
+		inline ::std::vector<Event> Events() { return Recorder::Default().Events(); }
+		inline void Reset() { Recorder::Default().Reset(); }
+		inline void WriteChromeTrace( ::std::ostream& stream ) { Recorder::Default().WriteChromeTrace( stream ); }
+
+		// Times one operator call from its construction to its destruction, which records the Event.
+		class Scope
+		{
+		public:
+			Scope( const char* name, ::std::uint64_t elementsIn )
+			{
+				event_.name = name;
+				event_.thread = Recorder::ThreadId();
+				event_.start = Recorder::Default().Now();
+				event_.duration = 0;
+				event_.elementsIn = elementsIn;
+				event_.elementsOut = 0;
+				event_.invocations = 0;
+				event_.bytesAllocated = 0;
+			}
+
+			Scope( const Scope& ) = delete;
+			Scope& operator=( const Scope& ) = delete;
+
+			~Scope()
+			{
+				event_.duration = Recorder::Default().Now() - event_.start;
+				Recorder::Default().Record( event_ );
+			}
+
+			void Output( ::std::uint64_t elementsOut, ::std::uint64_t bytesAllocated )
+			{
+				event_.elementsOut = elementsOut;
+				event_.bytesAllocated = bytesAllocated;
+			}
+
+			::std::uint64_t& ElementsIn() { return event_.elementsIn; }
+			::std::uint64_t& Invocations() { return event_.invocations; }
+
+		private:
+			Event event_;
+		};
+
+		// Wraps a predicate or selector so that every call is counted by a Scope, as an invocation or as an element in.
+		template<typename Func>
+		class Counted
+		{
+		public:
+			Counted( Func& func, ::std::uint64_t& counter )
+				: func_( &func )
+				, counter_( &counter )
+			{ }
+
+			template<typename... Args>
+			decltype( auto ) operator()( Args&&... args ) const
+			{
+				++*counter_;
+				return ( *func_ )( ::std::forward<Args>( args )... );
+			}
+
+		private:
+			Func* func_;
+			::std::uint64_t* counter_;
+		};
+
+		template<typename Func>
+		Counted<Func> MakeCounted( Func& func, Scope& scope ) { return Counted<Func>( func, scope.Invocations() ); }
+		template<typename Func>
+		Counted<Func> MakeCountedIn( Func& func, Scope& scope ) { return Counted<Func>( func, scope.ElementsIn() ); }
+
+	}
+#endif
+
+#pragma endregion
+
+#pragma region Statistics
+
+	// Count, sum, mean, minimum, maximum, variance and geometric and harmonic means of a sequence, gathered in one pass.
+	// The mean and the sum of squared deviations are kept in double and merged with the formulas of Welford and Chan et al.,
+	// so the variance does not suffer from the cancellation of sum( x^2 ) - sum( x )^2 / n.
+	// Minimum and Maximum throw out_of_range when Count is 0; the others return NaN.
+	template<typename T>
+	class Statistics
+	{
+	public:
+		using SizeType = ::std::size_t;
+
+	public:
+		constexpr Statistics()
+			: count_( 0 )
+			, sum_( 0.0 )
+			, mean_( 0.0 )
+			, m2_( 0.0 )
+			, sumLog_( 0.0 )
+			, sumReciprocal_( 0.0 )
+			, minimum_()
+			, maximum_()
+		{ }
+
+		// The number of elements per block of the SIMD kernels.
+		static constexpr SizeType BlockSize() { return 4096; }
+
+		// Contiguous elements are taken in blocks which stay in L1: each block gets its moments from the SIMD kernels, then is merged.
+		constexpr Statistics( const T* first, SizeType count )
+			: Statistics()
+		{
+			const auto blockSize = BlockSize();
+			for( SizeType offset = 0; offset < count; offset += blockSize )
+			{
+				const auto block = first + offset;
+				const auto size = ::std::min( blockSize, count - offset );
+
+				Statistics statistics;
+				statistics.count_ = size;
+				statistics.sum_ = Details::Simd::SumInDouble( block, size );
+				statistics.mean_ = statistics.sum_ / static_cast<double>( size );
+				statistics.m2_ = Details::Simd::SumOfSquaredDeviations( block, size, statistics.mean_ );
+				statistics.minimum_ = Details::Simd::Minimum( block, size );
+				statistics.maximum_ = Details::Simd::Maximum( block, size );
+				for( SizeType i = 0; i < size; ++i )
+				{
+					statistics.AddInverses( static_cast<double>( block[i] ) );
+				}
+				Merge( statistics );
+			}
+		}
+
+		constexpr void Add( T value )
+		{
+			const auto x = static_cast<double>( value );
+			if( count_ == 0 )
+			{
+				minimum_ = maximum_ = value;
+			}
+			else
+			{
+				minimum_ = ::std::min( minimum_, value );
+				maximum_ = ::std::max( maximum_, value );
+			}
+
+			++count_;
+			sum_ += x;
+			const auto delta = x - mean_;
+			mean_ += delta / static_cast<double>( count_ );
+			m2_ += delta * ( x - mean_ );
+			AddInverses( x );
+		}
+
+		constexpr void Merge( const Statistics& other )
+		{
+			if( other.count_ == 0 )
+			{
+				return;
+			}
+			if( count_ == 0 )
+			{
+				*this = other;
+				return;
+			}
+
+			const auto count = static_cast<double>( count_ + other.count_ );
+			const auto delta = other.mean_ - mean_;
+			mean_ += delta * static_cast<double>( other.count_ ) / count;
+			m2_ += other.m2_ + delta * delta * static_cast<double>( count_ ) * static_cast<double>( other.count_ ) / count;
+			sum_ += other.sum_;
+			sumLog_ += other.sumLog_;
+			sumReciprocal_ += other.sumReciprocal_;
+			count_ += other.count_;
+			minimum_ = ::std::min( minimum_, other.minimum_ );
+			maximum_ = ::std::max( maximum_, other.maximum_ );
+		}
+
+		constexpr SizeType Count() const { return count_; }
+		constexpr double Sum() const { return sum_; }
+		constexpr double Mean() const { return count_ != 0 ? mean_ : ::std::nan( "" ); }
+		constexpr T Minimum() const
+		{
+			if( count_ == 0 )
+			{
+				OUTOFRANGEEX
+			}
+			return minimum_;
+		}
+		constexpr T Maximum() const
+		{
+			if( count_ == 0 )
+			{
+				OUTOFRANGEEX
+			}
+			return maximum_;
+		}
+
+		// Population variance ( / n ) like Vectorable::Variance, and sample variance ( / ( n - 1 ) ).
+		constexpr double Variance() const { return count_ != 0 ? m2_ / static_cast<double>( count_ ) : ::std::nan( "" ); }
+		constexpr double SampleVariance() const { return count_ > 1 ? m2_ / static_cast<double>( count_ - 1 ) : ::std::nan( "" ); }
+		constexpr double StandardDeviation() const { return ::std::sqrt( Variance() ); }
+		constexpr double SampleStandardDeviation() const { return ::std::sqrt( SampleVariance() ); }
+
+		// exp( mean( log( x ) ) ) for positive elements, and n / sum( 1 / x ) for non-zero ones.
+		constexpr double GeometricMean() const { return count_ != 0 ? ::std::exp( sumLog_ / static_cast<double>( count_ ) ) : ::std::nan( "" ); }
+		constexpr double HarmonicMean() const { return count_ != 0 ? static_cast<double>( count_ ) / sumReciprocal_ : ::std::nan( "" ); }
+
+	private:
+		// The logarithm (the inverse of exp) and the reciprocal, whose means give the geometric and harmonic means.
+		constexpr void AddInverses( double x )
+		{
+			sumLog_ += ::std::log( x );
+			sumReciprocal_ += 1.0 / x;
+		}
+
+		SizeType count_;
+		double sum_;
+		double mean_;
+		double m2_;
+		double sumLog_;
+		double sumReciprocal_;
+		T minimum_;
+		T maximum_;
+	};
+
+	// Means, variances and co-moment of pairs ( x, y ), gathered in one pass like Statistics.
+	class BivariateStatistics
+	{
+	public:
+		using SizeType = ::std::size_t;
+
+	public:
+		BivariateStatistics()
+			: count_( 0 )
+			, meanX_( 0.0 )
+			, meanY_( 0.0 )
+			, m2X_( 0.0 )
+			, m2Y_( 0.0 )
+			, c_( 0.0 )
+		{ }
+
+		void Add( double x, double y )
+		{
+			++count_;
+			const auto deltaX = x - meanX_;
+			meanX_ += deltaX / static_cast<double>( count_ );
+			const auto deltaY = y - meanY_;
+			meanY_ += deltaY / static_cast<double>( count_ );
+			m2X_ += deltaX * ( x - meanX_ );
+			m2Y_ += deltaY * ( y - meanY_ );
+			c_ += deltaX * ( y - meanY_ );
+		}
+
+		void Merge( const BivariateStatistics& other )
+		{
+			if( other.count_ == 0 )
+			{
+				return;
+			}
+			if( count_ == 0 )
+			{
+				*this = other;
+				return;
+			}
+
+			const auto count = static_cast<double>( count_ + other.count_ );
+			const auto weight = static_cast<double>( count_ ) * static_cast<double>( other.count_ ) / count;
+			const auto deltaX = other.meanX_ - meanX_;
+			const auto deltaY = other.meanY_ - meanY_;
+			meanX_ += deltaX * static_cast<double>( other.count_ ) / count;
+			meanY_ += deltaY * static_cast<double>( other.count_ ) / count;
+			m2X_ += other.m2X_ + deltaX * deltaX * weight;
+			m2Y_ += other.m2Y_ + deltaY * deltaY * weight;
+			c_ += other.c_ + deltaX * deltaY * weight;
+			count_ += other.count_;
+		}
+
+		SizeType Count() const { return count_; }
+		double MeanX() const { return count_ != 0 ? meanX_ : ::std::nan( "" ); }
+		double MeanY() const { return count_ != 0 ? meanY_ : ::std::nan( "" ); }
+		double VarianceX() const { return count_ != 0 ? m2X_ / static_cast<double>( count_ ) : ::std::nan( "" ); }
+		double VarianceY() const { return count_ != 0 ? m2Y_ / static_cast<double>( count_ ) : ::std::nan( "" ); }
+
+		// Population covariance ( / n ) and Pearson's correlation coefficient.
+		double Covariance() const { return count_ != 0 ? c_ / static_cast<double>( count_ ) : ::std::nan( "" ); }
+		double Correlation() const { return count_ != 0 ? c_ / ::std::sqrt( m2X_ * m2Y_ ) : ::std::nan( "" ); }
+
+	private:
+		SizeType count_;
+		double meanX_;
+		double meanY_;
+		double m2X_;
+		double m2Y_;
+		double c_;
+	};
+
+#pragma endregion
+
+	template<typename T, typename Allocator>
+	class Vectorable
+	{
+		template<typename U, typename UAllocator> friend class Vectorable;
+
+	public:
+		using AllocatorType = Allocator;
+		using StorageType = ::std::vector<typename Details::Wrap<T>::type, Allocator>;
+		using SizeType = typename StorageType::size_type;
+		using ItrType = typename StorageType::iterator;
+		using ConstItrType = const typename Details::Wrap<T>::type*;
+
+		// The type of a result with elements of type U, which allocates from the same source.
+		template<typename U>
+		using RebindType = Vectorable<U, Details::RebindAllocatorT<Allocator, U>>;
+
+	public:
+
+#pragma region Constructors
+
+		constexpr Vectorable( SizeType size, const Allocator& allocator = Allocator() )
+			: data_( size, allocator )
+			, view_( nullptr )
+			, viewSize_( 0 )
+			, order_( Ordering::None )
+		{ }
+
+		constexpr Vectorable( T element, SizeType size, const Allocator& allocator = Allocator() )
+			: Vectorable( size, allocator )
+		{
+			::std::fill( ::std::begin( data_ ), ::std::end( data_ ), Details::MakeWrap( element ) );
+		}
+
+		template<typename FwdItr>
+		constexpr Vectorable( FwdItr begin, FwdItr end, const Allocator& allocator = Allocator() )
+			: Vectorable( static_cast<SizeType>( ::std::distance( begin, end ) ), allocator )
+		{
+			::std::transform(
+				begin,
+				end,
+				::std::begin( data_ ),
+				[]( T value ) { return Details::MakeWrap( value ); } );
+		}
+
+		constexpr explicit Vectorable( StorageType&& data )
+			: data_( ::std::move( data ) )
+			, view_( nullptr )
+			, viewSize_( 0 )
+			, order_( Ordering::None )
+		{ }
+
+		// Borrows [first, first + size) without copying. The memory must outlive this Vectorable and its copies.
+		constexpr Vectorable( ConstItrType first, SizeType size, Details::BorrowTag, const Allocator& allocator = Allocator() )
+			: data_( allocator )
+			, view_( size != 0 ? first : nullptr )
+			, viewSize_( size )
+			, order_( Ordering::None )
+		{ }
+
+		// Borrows [first, first + size), and keeps owner (e.g. a file mapping) alive as long as this Vectorable or a copy uses it.
+		constexpr Vectorable( ConstItrType first, SizeType size, ::std::shared_ptr<const void> owner, const Allocator& allocator = Allocator() )
+			: data_( allocator )
+			, view_( size != 0 ? first : nullptr )
+			, viewSize_( size )
+			, owner_( ::std::move( owner ) )
+			, order_( Ordering::None )
+		{ }
+
+#pragma endregion
+
+#pragma region Getter
+
+		// Begin/End give mutable access, so a borrowed view is copied into its own buffer first, and the ordering is forgotten.
+		constexpr ItrType Begin() { Detach(); order_ = Ordering::None; return ::std::begin( data_ ); }
+		constexpr ItrType End() { Detach(); order_ = Ordering::None; return ::std::end( data_ ); }
+
+		constexpr ConstItrType CBegin() const { return view_ != nullptr ? view_ : data_.data(); }
+		constexpr ConstItrType CEnd() const { return CBegin() + Count(); }
+
+		constexpr bool IsBorrowed() const { return view_ != nullptr; }
+
+		constexpr Ordering GetOrdering() const { return order_; }
+
+		// The allocator of the buffer; the results of operators allocate from (a rebound copy of) it.
+		constexpr Allocator GetAllocator() const { return data_.get_allocator(); }
+
+		constexpr T First() const { return Details::Unwrap( *CBegin() ); }
+		constexpr T Last() const { return Details::Unwrap( *( CEnd() - 1 ) ); }
+		constexpr T At( SizeType index ) const
+		{
+			if( index >= Count() )
+			{
+				OUTOFRANGEEX
+			}
+
+			return Details::Unwrap( CBegin()[index] );
+		}
+
+		template<typename Predicate> constexpr T First( Predicate predicate ) const { return Where( predicate ).First(); }
+		template<typename Predicate> constexpr T Last( Predicate predicate ) const { return Where( predicate ).Last(); }
+
+#pragma endregion
+
+#pragma region Conditional Judgement
+
+		constexpr bool All( T element ) const
+		{
+			return ::std::all_of( CBegin(), CEnd(), ::std::bind( ::std::equal_to<T>(), ::std::placeholders::_1, element ) );
+		}
+		template<typename Predicate, typename = Details::InvokeResultT<Predicate, T>>
+		constexpr bool All( Predicate predicate ) const
+		{
+			return ::std::all_of( CBegin(), CEnd(), predicate );
+		}
+
+		constexpr bool Any( T element ) const
+		{
+			return ::std::any_of( CBegin(), CEnd(), ::std::bind( ::std::equal_to<T>(), ::std::placeholders::_1, element ) );
+		}
+		template<typename Predicate, typename = Details::InvokeResultT<Predicate, T>>
+		constexpr bool Any( Predicate predicate ) const
+		{
+			return ::std::any_of( CBegin(), CEnd(), predicate );
+		}
+
+		constexpr bool None( T element ) const
+		{
+			return ::std::none_of( CBegin(), CEnd(), ::std::bind( ::std::equal_to<T>(), ::std::placeholders::_1, element ) );
+		}
+		template<typename Predicate, typename = Details::InvokeResultT<Predicate, T>>
+		constexpr bool None( Predicate predicate ) const
+		{
+			return ::std::none_of( CBegin(), CEnd(), predicate );
+		}
+
+		constexpr bool Empty() const
+		{
+			return Count() == 0;
+		}
+
+		constexpr bool SequenceEqual( Vectorable second ) const
+		{
+			return Count() == second.Count() && ::std::equal( CBegin(), CEnd(), second.CBegin() );
+		}
+
+		// A sorted sequence is binary searched.
+		constexpr bool Contain( T element ) const
+		{
+			if( order_ != Ordering::None )
+			{
+				const auto range = EqualRange( element );
+				return range.first != range.second;
+			}
+			return ::std::find( CBegin(), CEnd(), element ) != CEnd();
+		}
+		constexpr bool Contain( Vectorable second ) const
+		{
+			return second.All( [this]( T value ) { return Contain( value ); } );
+		}
+		constexpr bool Include( T element ) const { return Contain( element ); }
+		constexpr bool Include( Vectorable second ) const { return Contain( second ); }
+
+#pragma endregion
+
+#pragma region Basic Calc
+
+		constexpr SizeType Count() const { return view_ != nullptr ? viewSize_ : data_.size(); }
+		constexpr SizeType Count( T element ) const
+		{
+			if( order_ != Ordering::None )
+			{
+				const auto range = EqualRange( element );
+				return static_cast<SizeType>( range.second - range.first );
+			}
+			return ::std::count( CBegin(), CEnd(), element );
+		}
+		template<typename Predicate, typename = Details::InvokeResultT<Predicate, T>>
+		constexpr SizeType Count( Predicate predicate ) const
+		{
+			LINQINSTRUMENT( "Count" )
+			LINQINSTRUMENTOUT( 1, 0 )
+			return ::std::count_if( CBegin(), CEnd(), LINQCOUNTED( predicate ) );
+		}
+
+		constexpr T Sum() const
+		{
+			ARITHMETICABLECHECK
+
+			LINQINSTRUMENT( "Sum" )
+			LINQINSTRUMENTOUT( 1, 0 )
+			return Details::Simd::Sum( CBegin(), Count() );
+		}
+
+		constexpr T Average() const
+		{
+			ARITHMETICABLECHECK
+
+			return Sum() / static_cast<T>( Count() );
+		}
+		template<typename S>
+		constexpr S Average() const
+		{
+			ARITHMETICABLECHECK
+
+			return Cast<S>().Average();
+		}	
+		constexpr T Mean() const { return Average(); }
+		template<typename S> constexpr S Mean() const { return Average<S>(); }
+
+		constexpr T Minimum() const
+		{
+			ARITHMETICABLECHECK
+
+			if( Count() == 0 )
+			{
+				OUTOFRANGEEX
+			}
+			if( order_ != Ordering::None )
+			{
+				return order_ == Ordering::Ascending ? First() : Last();
+			}
+			return Details::Simd::Minimum( CBegin(), Count() );
+		}
+
+		constexpr T Maximum() const
+		{
+			ARITHMETICABLECHECK
+
+			if( Count() == 0 )
+			{
+				OUTOFRANGEEX
+			}
+			if( order_ != Ordering::None )
+			{
+				return order_ == Ordering::Ascending ? Last() : First();
+			}
+			return Details::Simd::Maximum( CBegin(), Count() );
+		}
+
+		constexpr T Median() const
+		{
+			ARITHMETICABLECHECK
+
+			const auto count = Count();
+			if( count == 0 )
+			{
+				OUTOFRANGEEX
+			}
+
+			const auto halfCount = count / static_cast<SizeType>( 2 );
+			if( order_ != Ordering::None )
+			{
+				// The same middle elements, at hand: the i-th smallest is at i, or at count - 1 - i when descending.
+				const auto lower = order_ == Ordering::Ascending ? At( halfCount - ( count % 2 == 0 ? 1 : 0 ) ) : At( count - 1 - halfCount + ( count % 2 == 0 ? 1 : 0 ) );
+				const auto upper = order_ == Ordering::Ascending ? At( halfCount ) : At( count - 1 - halfCount );
+				return count % 2 == 0 ? ( lower + upper ) / 2 : upper;
+			}
+
+			::std::vector<T> values( CBegin(), CEnd() );
+			const auto half = values.begin() + halfCount;
+			::std::nth_element( values.begin(), half, values.end() );
+			return count % 2 == 0 ? ( *::std::max_element( values.begin(), half ) + *half ) / 2 : *half;
+		}
+
+		// The element at index n of the sorted sequence, without sorting it.
+		constexpr T NthElement( SizeType n ) const
+		{
+			if( n >= Count() )
+			{
+				OUTOFRANGEEX
+			}
+
+			StorageType values( CBegin(), CEnd(), GetAllocator() );
+			const auto nth = values.begin() + n;
+			::std::nth_element( values.begin(), nth, values.end() );
+			return Details::Unwrap( *nth );
+		}
+
+		// Quantiles interpolate linearly between the closest ranks: q = 0 is the minimum, q = 1 the maximum
+		// (the same definition as Excel PERCENTILE.INC and NumPy's default). The result is computed in double and cast to S.
+		template<typename S = T>
+		constexpr S Quantile( double q ) const
+		{
+			return Quantiles<S>( { q } )[0];
+		}
+
+		template<typename S = T>
+		constexpr S Percentile( double p ) const
+		{
+			return Quantile<S>( p / 100.0 );
+		}
+
+		// All the quantiles come from one copy of the elements, and the selections for the ranks share their partitioning.
+		template<typename S = T>
+		constexpr ::std::vector<S> Quantiles( const ::std::vector<double>& qs ) const
+		{
+			ARITHMETICABLECHECK
+
+			const auto count = Count();
+			if( count == 0 )
+			{
+				OUTOFRANGEEX
+			}
+
+			::std::vector<SizeType> ranks;
+			ranks.reserve( qs.size() * 2 );
+			for( const auto q : qs )
+			{
+				if( !( q >= 0.0 && q <= 1.0 ) )
+				{
+					OUTOFRANGEEX
+				}
+				const auto lower = static_cast<SizeType>( q * static_cast<double>( count - 1 ) );
+				ranks.push_back( lower );
+				ranks.push_back( ::std::min( lower + 1, count - 1 ) );
+			}
+			::std::sort( ranks.begin(), ranks.end() );
+			ranks.erase( ::std::unique( ranks.begin(), ranks.end() ), ranks.end() );
+
+			::std::vector<T> values( CBegin(), CEnd() );
+			Details::NthElements( values.begin(), values.begin(), values.end(), ranks.cbegin(), ranks.cend() );
+
+			::std::vector<S> ret;
+			ret.reserve( qs.size() );
+			for( const auto q : qs )
+			{
+				const auto position = q * static_cast<double>( count - 1 );
+				const auto lower = static_cast<SizeType>( position );
+				const auto lowerValue = static_cast<double>( values[lower] );
+				const auto upperValue = static_cast<double>( values[::std::min( lower + 1, count - 1 )] );
+				ret.push_back( static_cast<S>( lowerValue + ( position - static_cast<double>( lower ) ) * ( upperValue - lowerValue ) ) );
+			}
+			return ret;
+		}
+
+		constexpr T Variance() const
+		{
+			ARITHMETICABLECHECK
+
+			return Variance( ::std::is_floating_point<T>() );
+		}
+		constexpr T StandardDeviation() const { return static_cast<T>( Details::Sqrt( Variance() ) ); }
+
+		// Count, sum, mean, minimum, maximum, variance and geometric and harmonic means in one pass over the elements.
+		constexpr Statistics<T> Stats() const
+		{
+			ARITHMETICABLECHECK
+
+			return Statistics<T>( CBegin(), Count() );
+		}
+
+		// exp( mean( log( x ) ) ), computed in double by Stats. The elements must be positive.
+		template<typename S = T>
+		constexpr S GeometricMean() const
+		{
+			ARITHMETICABLECHECK
+
+			if( Count() == 0 )
+			{
+				OUTOFRANGEEX
+			}
+			return static_cast<S>( Stats().GeometricMean() );
+		}
+		template<typename S = T> constexpr S GeometricAverage() const { return GeometricMean<S>(); }
+
+		// n / sum( 1 / x ), computed in double by Stats. The elements must be non-zero.
+		template<typename S = T>
+		constexpr S HarmonicMean() const
+		{
+			ARITHMETICABLECHECK
+
+			if( Count() == 0 )
+			{
+				OUTOFRANGEEX
+			}
+			return static_cast<S>( Stats().HarmonicMean() );
+		}
+		template<typename S = T> constexpr S HarmonicAverage() const { return HarmonicMean<S>(); }
+
+		// Population covariance and Pearson's correlation with the element at the same index of other, in one pass.
+		template<typename U, typename UAllocator>
+		constexpr double Covariance( const Vectorable<U, UAllocator>& other ) const { return Bivariate( other ).Covariance(); }
+		template<typename U, typename UAllocator>
+		constexpr double Correlation( const Vectorable<U, UAllocator>& other ) const { return Bivariate( other ).Correlation(); }
+
+		template<typename Func>
+		constexpr T Aggregate( T seed, Func func ) const
+		{
+			ARITHMETICABLECHECK
+
+			LINQINSTRUMENT( "Aggregate" )
+			LINQINSTRUMENTOUT( 1, 0 )
+			return ::std::accumulate( CBegin(), CEnd(), seed, LINQCOUNTED( func ) );
+		}
+
+		template<typename S = void, typename Func, typename ResultSelector, typename R = Details::SelectResultT<S, ResultSelector, T>>
+		constexpr R Aggregate( T seed, Func func, ResultSelector resultSelector ) const
+		{
+			ARITHMETICABLECHECK
+
+			return resultSelector( ::std::accumulate( CBegin(), CEnd(), seed, func ) );
+		}
+
+#pragma endregion
+
+#pragma region Filtering
+
+#ifdef __cplusplus_winrt
+		template<typename T>
+		Vectorable OfType() const
+		{
+			return OfType( T::typeid );
+		}
+
+		Vectorable OfType( Windows::UI::Xaml::Interop::TypeName typeName ) const
+		{
+			static_assert( __is_valid_winrt_type( typename Details::Wrap<T>::type ), "T is winrt type only." );
+
+			return Where( [typeName]( typename Details::Wrap<T>::type value )
+			{
+				return ::Windows::UI::Xaml::Interop::TypeName( Details::Unwrap( value )->GetType() ).Name == typeName.Name;
+			} );
+		}
+#endif	
+		constexpr Vectorable EqualTo( T value ) const
+		{
+			return Where( ::std::bind( ::std::equal_to<>(), ::std::placeholders::_1, value ) );
+		}
+
+		constexpr Vectorable NotEqualTo( T value ) const
+		{
+			return Where( ::std::bind( ::std::not_equal_to<>(), ::std::placeholders::_1, value ) );
+		}
+
+		constexpr Vectorable LessThan( T value ) const
+		{
+			ARITHMETICABLECHECK
+
+			return Where( ::std::bind( ::std::less<>(), ::std::placeholders::_1, value ) );
+		}
+
+		constexpr Vectorable LessThanOrEqualTo( T value ) const
+		{
+			ARITHMETICABLECHECK
+
+			return Where( ::std::bind( ::std::less_equal<>(), ::std::placeholders::_1, value ) );
+		}
+
+		constexpr Vectorable GreaterThan( T value ) const
+		{
+			ARITHMETICABLECHECK
+
+			return Where( ::std::bind( ::std::greater<>(), ::std::placeholders::_1, value ) );
+		}
+
+		constexpr Vectorable GreaterThanOrEqualTo( T value ) const
+		{
+			ARITHMETICABLECHECK
+
+			return Where( ::std::bind( ::std::greater_equal<>(), ::std::placeholders::_1, value ) );
+		}
+
+		template<typename Predicate>
+		constexpr Vectorable Where( Predicate predicate ) const &
+		{
+			LINQINSTRUMENT( "Where" )
+			Vectorable ret( Count(), GetAllocator() );
+			auto itr = ::std::copy_if( CBegin(), CEnd(), ::std::begin( ret.data_ ), LINQCOUNTED( predicate ) );
+			ret.data_.resize( ::std::distance( ::std::begin( ret.data_ ), itr ) );
+			ret.order_ = order_;
+			LINQINSTRUMENTOUT( ret.Count(), Details::CapacityBytes( ret.data_ ) )
+			return ret;
+		}
+		template<typename Predicate>
+		constexpr Vectorable Where( Predicate predicate ) &&
+		{
+			if( IsBorrowed() )
+			{
+				return static_cast<const Vectorable&>( *this ).Where( predicate );
+			}
+
+			LINQINSTRUMENT( "Where" )
+			data_.erase(
+				::std::remove_if( ::std::begin( data_ ), ::std::end( data_ ), [&]( const typename Details::Wrap<T>::type& value ) { return !LINQCOUNTED( predicate )( value ); } ),
+				::std::end( data_ ) );
+			LINQINSTRUMENTOUT( Count(), 0 )
+			return ::std::move( *this );
+		}
+
+#pragma endregion
+
+#pragma region Basic Operation
+
+		// The && overloads reuse the buffer of a temporary in place, so a chain like From( v ).Where( p ).OrderBy().Reverse()
+		// allocates once. A borrowed temporary has no buffer to reuse and takes the const & path.
+		constexpr Vectorable Skip( SizeType count ) const &
+		{
+			LINQINSTRUMENT( "Skip" )
+			const auto size = Count();
+
+			if( count > size )
+			{
+				OUTOFRANGEEX
+			}
+
+			Vectorable ret( size - count, GetAllocator() );
+			auto begin = CBegin();
+			::std::advance( begin, count );
+			::std::copy( begin, CEnd(), ::std::begin( ret.data_ ) );
+			ret.order_ = order_;
+			LINQINSTRUMENTOUT( ret.Count(), Details::CapacityBytes( ret.data_ ) )
+			return ret;
+		}
+		constexpr Vectorable Skip( SizeType count ) &&
+		{
+			if( IsBorrowed() )
+			{
+				return static_cast<const Vectorable&>( *this ).Skip( count );
+			}
+
+			LINQINSTRUMENT( "Skip" )
+			if( count > Count() )
+			{
+				OUTOFRANGEEX
+			}
+
+			data_.erase( ::std::begin( data_ ), ::std::begin( data_ ) + count );
+			LINQINSTRUMENTOUT( Count(), 0 )
+			return ::std::move( *this );
+		}
+
+		template<typename Predicate>
+		constexpr Vectorable SkipWhile( Predicate predicate ) const &
+		{
+			return Skip( PrefixLength( predicate, "SkipWhile" ) );
+		}
+		template<typename Predicate>
+		constexpr Vectorable SkipWhile( Predicate predicate ) &&
+		{
+			const auto count = PrefixLength( predicate, "SkipWhile" );
+			return ::std::move( *this ).Skip( count );
+		}
+
+		constexpr Vectorable Take( SizeType count ) const &
+		{
+			return TakeWhile( [&count]( T ) { return count-- != 0; } );
+		}
+		constexpr Vectorable Take( SizeType count ) &&
+		{
+			return ::std::move( *this ).TakeWhile( [&count]( T ) { return count-- != 0; } );
+		}
+
+		template<typename Predicate>
+		constexpr Vectorable TakeWhile( Predicate predicate ) const &
+		{
+			LINQINSTRUMENT( "TakeWhile" )
+			const auto size = Count();
+
+			Vectorable ret( size, GetAllocator() );
+
+			SizeType i = 0;
+			for( ; i < size; ++i )
+			{
+				const auto data = CBegin()[i];
+				if( !LINQCOUNTED( predicate )( data ) )
+				{
+					break;
+				}
+
+				ret.data_[i] = data;
+			}
+
+			ret.data_.resize( i );
+			ret.order_ = order_;
+			LINQINSTRUMENTOUT( ret.Count(), Details::CapacityBytes( ret.data_ ) )
+			return ret;
+		}
+		template<typename Predicate>
+		constexpr Vectorable TakeWhile( Predicate predicate ) &&
+		{
+			if( IsBorrowed() )
+			{
+				return static_cast<const Vectorable&>( *this ).TakeWhile( predicate );
+			}
+
+			data_.erase( ::std::begin( data_ ) + PrefixLength( predicate, "TakeWhile" ), ::std::end( data_ ) );
+			return ::std::move( *this );
+		}
+
+		constexpr Vectorable Reverse() const &
+		{
+			LINQINSTRUMENT( "Reverse" )
+			Vectorable ret( Count(), GetAllocator() );
+			::std::reverse_copy( CBegin(), CEnd(), ::std::begin( ret.data_ ) );
+			ret.order_ = Reversed( order_ );
+			LINQINSTRUMENTOUT( ret.Count(), Details::CapacityBytes( ret.data_ ) )
+			return ret;
+		}
+		constexpr Vectorable Reverse() &&
+		{
+			if( IsBorrowed() )
+			{
+				return static_cast<const Vectorable&>( *this ).Reverse();
+			}
+
+			LINQINSTRUMENT( "Reverse" )
+			::std::reverse( ::std::begin( data_ ), ::std::end( data_ ) );
+			order_ = Reversed( order_ );
+			LINQINSTRUMENTOUT( Count(), 0 )
+			return ::std::move( *this );
+		}
+
+		constexpr Vectorable Rotate( SizeType advance ) const &
+		{
+			LINQINSTRUMENT( "Rotate" )
+			Vectorable ret( Count(), GetAllocator() );
+			auto itr = CBegin();
+			::std::advance( itr, advance );
+			::std::rotate_copy( CBegin(), itr, CEnd(), ::std::begin( ret.data_ ) );
+			LINQINSTRUMENTOUT( ret.Count(), Details::CapacityBytes( ret.data_ ) )
+			return ret;
+		}
+		constexpr Vectorable Rotate( SizeType advance ) &&
+		{
+			if( IsBorrowed() )
+			{
+				return static_cast<const Vectorable&>( *this ).Rotate( advance );
+			}
+
+			LINQINSTRUMENT( "Rotate" )
+			::std::rotate( ::std::begin( data_ ), ::std::begin( data_ ) + advance, ::std::end( data_ ) );
+			order_ = Ordering::None;
+			LINQINSTRUMENTOUT( Count(), 0 )
+			return ::std::move( *this );
+		}
+
+		constexpr Vectorable OrderBy() const &
+		{
+			return View().Sort( ::std::less<>() );
+		}
+		constexpr Vectorable OrderBy() &&
+		{
+			return ::std::move( *this ).Sort( ::std::less<>() );
+		}
+		template<typename Predicate, typename = Details::InvokeResultT<Predicate, T, T>>
+		constexpr Vectorable OrderBy( Predicate predicate ) const &
+		{
+			return View().Sort( predicate );
+		}
+		template<typename Predicate, typename = Details::InvokeResultT<Predicate, T, T>>
+		constexpr Vectorable OrderBy( Predicate predicate ) &&
+		{
+			return ::std::move( *this ).Sort( predicate );
+		}
+
+		constexpr Vectorable OrderByDescending() const &
+		{
+			return View().Sort( ::std::greater<>() );
+		}
+		constexpr Vectorable OrderByDescending() &&
+		{
+			return ::std::move( *this ).Sort( ::std::greater<>() );
+		}
+
+		// Like .NET, OrderBy and OrderByDescending with a key selector are stable, and ThenBy / ThenByDescending on their result
+		// order the ties by more keys. Nothing is sorted until ToVectorable (or to_vector) is called on the OrderedVectorable.
+		template<typename KeySelector, typename = Details::InvokeResultT<KeySelector, T>>
+		constexpr OrderedVectorable<T, Allocator, Details::SortLevel<KeySelector, false>> OrderBy( KeySelector keySelector ) const &
+		{
+			return OrderedVectorable<T, Allocator, Details::SortLevel<KeySelector, false>>( View(), ::std::make_tuple( Details::SortLevel<KeySelector, false> { keySelector } ) );
+		}
+		template<typename KeySelector, typename = Details::InvokeResultT<KeySelector, T>>
+		constexpr OrderedVectorable<T, Allocator, Details::SortLevel<KeySelector, false>> OrderBy( KeySelector keySelector ) &&
+		{
+			return OrderedVectorable<T, Allocator, Details::SortLevel<KeySelector, false>>( ::std::move( *this ), ::std::make_tuple( Details::SortLevel<KeySelector, false> { keySelector } ) );
+		}
+
+		template<typename KeySelector, typename = Details::InvokeResultT<KeySelector, T>>
+		constexpr OrderedVectorable<T, Allocator, Details::SortLevel<KeySelector, true>> OrderByDescending( KeySelector keySelector ) const &
+		{
+			return OrderedVectorable<T, Allocator, Details::SortLevel<KeySelector, true>>( View(), ::std::make_tuple( Details::SortLevel<KeySelector, true> { keySelector } ) );
+		}
+		template<typename KeySelector, typename = Details::InvokeResultT<KeySelector, T>>
+		constexpr OrderedVectorable<T, Allocator, Details::SortLevel<KeySelector, true>> OrderByDescending( KeySelector keySelector ) &&
+		{
+			return OrderedVectorable<T, Allocator, Details::SortLevel<KeySelector, true>>( ::std::move( *this ), ::std::make_tuple( Details::SortLevel<KeySelector, true> { keySelector } ) );
+		}
+
+#pragma endregion
+
+#pragma region Windowing
+
+		// Consecutive batches of size elements, the last one with the rest.
+		constexpr RebindType<Vectorable> Chunk( SizeType size ) const
+		{
+			return Windows( size, size, true );
+		}
+
+		// The windows of size elements which start at 0, step, 2 * step, ... and fit in the sequence.
+		constexpr RebindType<Vectorable> Window( SizeType size, SizeType step = 1 ) const
+		{
+			return Windows( size, step, false );
+		}
+
+		// The moving aggregates have one value per window of size consecutive elements (Count() - size + 1 of them),
+		// and are computed in one pass into one buffer: the sums and variances are updated with the element which enters
+		// and the one which leaves the window, and the extremes are kept in a monotonic deque of candidates.
+		constexpr Vectorable MovingSum( SizeType size ) const
+		{
+			ARITHMETICABLECHECK
+
+			LINQINSTRUMENT( "MovingSum" )
+			auto ret = MovingSum<T>( size, 1 );
+			LINQINSTRUMENTOUT( ret.Count(), Details::CapacityBytes( ret.data_ ) )
+			return ret;
+		}
+
+		// The averages are computed in S: truncated like Average for integers, unless S is a floating point type.
+		template<typename S = T>
+		constexpr RebindType<S> MovingAverage( SizeType size ) const
+		{
+			ARITHMETICABLECHECK
+
+			LINQINSTRUMENT( "MovingAverage" )
+			auto ret = MovingSum<S>( size, size );
+			LINQINSTRUMENTOUT( ret.Count(), Details::CapacityBytes( ret.data_ ) )
+			return ret;
+		}
+
+		constexpr Vectorable MovingMinimum( SizeType size ) const
+		{
+			ARITHMETICABLECHECK
+
+			LINQINSTRUMENT( "MovingMinimum" )
+			auto ret = MovingExtreme( size, ::std::less<>() );
+			LINQINSTRUMENTOUT( ret.Count(), Details::CapacityBytes( ret.data_ ) )
+			return ret;
+		}
+
+		constexpr Vectorable MovingMaximum( SizeType size ) const
+		{
+			ARITHMETICABLECHECK
+
+			LINQINSTRUMENT( "MovingMaximum" )
+			auto ret = MovingExtreme( size, ::std::greater<>() );
+			LINQINSTRUMENTOUT( ret.Count(), Details::CapacityBytes( ret.data_ ) )
+			return ret;
+		}
+
+		// The population variance of each window, with the mean and the sum of squared deviations in double (Welford's update
+		// for a sliding window), cast to S.
+		template<typename S = T>
+		constexpr RebindType<S> MovingVariance( SizeType size ) const
+		{
+			ARITHMETICABLECHECK
+
+			LINQINSTRUMENT( "MovingVariance" )
+			RebindType<S> ret( MovingCount( size ), RebindAllocator<S>() );
+			const auto first = CBegin();
+			const auto windowSize = static_cast<double>( size );
+			auto mean = 0.0;
+			auto m2 = 0.0;
+			for( SizeType i = 0; i < ret.Count(); ++i )
+			{
+				// Started again every size windows, so the rounding errors of the updates do not add up over the sequence.
+				if( i % size == 0 )
+				{
+					Statistics<double> window;
+					::std::for_each( first + i, first + i + size, [&window]( T value ) { window.Add( static_cast<double>( value ) ); } );
+					mean = window.Mean();
+					m2 = window.Variance() * windowSize;
+				}
+				else
+				{
+					const auto entering = static_cast<double>( first[i + size - 1] );
+					const auto leaving = static_cast<double>( first[i - 1] );
+					const auto previousMean = mean;
+					mean += ( entering - leaving ) / windowSize;
+					m2 = ::std::max( m2 + ( entering - leaving ) * ( entering - mean + leaving - previousMean ), 0.0 );
+				}
+				ret.data_[i] = static_cast<S>( m2 / windowSize );
+			}
+			LINQINSTRUMENTOUT( ret.Count(), Details::CapacityBytes( ret.data_ ) )
+			return ret;
+		}
+
+#pragma endregion
+
+#pragma region Set Calc
+
+		// The set operators without a predicate, or with hash and equal, use a Details::FlatHashSet and run in expected O( n + m ).
+		// Like .NET LINQ, the result has no duplicates and keeps the order of first occurrence.
+		// The overloads with one predicate are the sort based versions: for Distinct it compares adjacent elements,
+		// for the others it is the ordering of the sort.
+		// A sorted sequence has its duplicates next to each other, so it needs no hash set.
+		constexpr Vectorable Distinct() const &
+		{
+			return order_ != Ordering::None
+				? Distinct( ::std::equal_to<>() )
+				: Distinct( ::std::hash<typename Details::Wrap<T>::type>(), ::std::equal_to<typename Details::Wrap<T>::type>() );
+		}
+		constexpr Vectorable Distinct() &&
+		{
+			return order_ != Ordering::None
+				? ::std::move( *this ).Distinct( ::std::equal_to<>() )
+				: ::std::move( *this ).Distinct( ::std::hash<typename Details::Wrap<T>::type>(), ::std::equal_to<typename Details::Wrap<T>::type>() );
+		}
+		template<typename Predicate>
+		constexpr Vectorable Distinct( Predicate predicate ) const &
+		{
+			LINQINSTRUMENT( "Distinct" )
+			StorageType ret( GetAllocator() );
+			::std::unique_copy( CBegin(), CEnd(), ::std::back_inserter( ret ), LINQCOUNTED( predicate ) );
+			LINQINSTRUMENTOUT( ret.size(), Details::CapacityBytes( ret ) )
+			return WithOrdering( Vectorable( ::std::move( ret ) ), order_ );
+		}
+		template<typename Predicate>
+		constexpr Vectorable Distinct( Predicate predicate ) &&
+		{
+			if( IsBorrowed() )
+			{
+				return static_cast<const Vectorable&>( *this ).Distinct( predicate );
+			}
+
+			LINQINSTRUMENT( "Distinct" )
+			data_.erase( ::std::unique( ::std::begin( data_ ), ::std::end( data_ ), LINQCOUNTED( predicate ) ), ::std::end( data_ ) );
+			LINQINSTRUMENTOUT( Count(), 0 )
+			return ::std::move( *this );
+		}
+		template<typename Hash, typename KeyEqual>
+		constexpr Vectorable Distinct( Hash hash, KeyEqual equal ) const &
+		{
+			LINQINSTRUMENT( "Distinct" )
+			Details::FlatHashSet<typename Details::Wrap<T>::type, Hash, KeyEqual> set( hash, equal, Count() );
+			for( auto itr = CBegin(); itr != CEnd(); ++itr )
+			{
+				set.Insert( *itr );
+			}
+			auto ret = Adopt( set.ReleaseKeys() );
+			ret.order_ = order_;
+			LINQINSTRUMENTOUT( ret.Count(), Details::CapacityBytes( ret.data_ ) )
+			return ret;
+		}
+		// The first occurrences are compacted to the front of the buffer; only the hash set is allocated.
+		template<typename Hash, typename KeyEqual>
+		constexpr Vectorable Distinct( Hash hash, KeyEqual equal ) &&
+		{
+			if( IsBorrowed() )
+			{
+				return static_cast<const Vectorable&>( *this ).Distinct( hash, equal );
+			}
+
+			LINQINSTRUMENT( "Distinct" )
+			Details::FlatHashSet<typename Details::Wrap<T>::type, Hash, KeyEqual> set( hash, equal, Count() );
+			auto last = ::std::begin( data_ );
+			for( auto itr = ::std::begin( data_ ); itr != ::std::end( data_ ); ++itr )
+			{
+				if( set.Insert( *itr ).second )
+				{
+					if( last != itr )
+					{
+						*last = ::std::move( *itr );
+					}
+					++last;
+				}
+			}
+			data_.erase( last, ::std::end( data_ ) );
+			LINQINSTRUMENTOUT( Count(), 0 )
+			return ::std::move( *this );
+		}
+
+		constexpr Vectorable Concat( Vectorable second ) const &
+		{
+			LINQINSTRUMENTIN( "Concat", Count() + second.Count() )
+			Vectorable ret( Count() + second.Count(), GetAllocator() );
+			auto itr = ::std::copy( CBegin(), CEnd(), ::std::begin( ret.data_ ) );
+			::std::copy( second.CBegin(), second.CEnd(), itr );
+			LINQINSTRUMENTOUT( ret.Count(), Details::CapacityBytes( ret.data_ ) )
+			return ret;
+		}
+		constexpr Vectorable Concat( Vectorable second ) &&
+		{
+			if( IsBorrowed() )
+			{
+				return static_cast<const Vectorable&>( *this ).Concat( ::std::move( second ) );
+			}
+
+			LINQINSTRUMENTIN( "Concat", Count() + second.Count() )
+			LINQINSTRUMENTOUT( Count() + second.Count(), Count() + second.Count() > data_.capacity() ? ( Count() + second.Count() ) * sizeof( typename StorageType::value_type ) : 0 )
+			data_.insert( ::std::end( data_ ), second.CBegin(), second.CEnd() );
+			order_ = Ordering::None;
+			return ::std::move( *this );
+		}
+
+		// When both are sorted in the same order, Except and Intersect merge them instead, with Details::Gallop.
+		constexpr Vectorable Except( Vectorable second ) const
+		{
+			if( order_ != Ordering::None && second.order_ == order_ )
+			{
+				return order_ == Ordering::Ascending ? SortedExcept( second, ::std::less<>() ) : SortedExcept( second, ::std::greater<>() );
+			}
+			return Except( ::std::move( second ), ::std::hash<typename Details::Wrap<T>::type>(), ::std::equal_to<typename Details::Wrap<T>::type>() );
+		}
+		template<typename Predicate>
+		constexpr Vectorable Except( Vectorable second, Predicate predicate ) const
+		{
+			LINQINSTRUMENTIN( "Except", Count() + second.Count() )
+			StorageType ret( GetAllocator() );
+			auto sortedFirst = SortedBy( predicate );
+			auto sortedSecond = ::std::move( second ).SortedBy( predicate );
+			::std::set_difference(
+				sortedFirst.CBegin(),
+				sortedFirst.CEnd(),
+				sortedSecond.CBegin(),
+				sortedSecond.CEnd(),
+				::std::back_inserter( ret ),
+				LINQCOUNTED( predicate ) );
+			LINQINSTRUMENTOUT( ret.size(), Details::CapacityBytes( ret ) )
+			return WithOrdering( Vectorable( ::std::move( ret ) ), Details::OrderingOf<Predicate, T>::value );
+		}
+		// The keys of second are inserted first, so the elements of this which are inserted after them are the result.
+		template<typename Hash, typename KeyEqual>
+		constexpr Vectorable Except( Vectorable second, Hash hash, KeyEqual equal ) const
+		{
+			LINQINSTRUMENTIN( "Except", Count() + second.Count() )
+			Details::FlatHashSet<typename Details::Wrap<T>::type, Hash, KeyEqual> set( hash, equal, Count() + second.Count() );
+			for( auto itr = second.CBegin(); itr != second.CEnd(); ++itr )
+			{
+				set.Insert( *itr );
+			}
+			const auto excluded = set.Count();
+			for( auto itr = CBegin(); itr != CEnd(); ++itr )
+			{
+				set.Insert( *itr );
+			}
+
+			auto keys = set.ReleaseKeys();
+			keys.erase( ::std::begin( keys ), ::std::begin( keys ) + excluded );
+			auto ret = Adopt( ::std::move( keys ) );
+			ret.order_ = order_;
+			LINQINSTRUMENTOUT( ret.Count(), Details::CapacityBytes( ret.data_ ) )
+			return ret;
+		}
+		constexpr Vectorable Differ( Vectorable second ) const { return Except( second ); }
+		template<typename Predicate> constexpr Vectorable Differ( Vectorable second, Predicate predicate ) const { return Except( second, predicate ); }
+		template<typename Hash, typename KeyEqual> constexpr Vectorable Differ( Vectorable second, Hash hash, KeyEqual equal ) const { return Except( second, hash, equal ); }
+
+		constexpr Vectorable Union( Vectorable second ) const
+		{
+			return Union( ::std::move( second ), ::std::hash<typename Details::Wrap<T>::type>(), ::std::equal_to<typename Details::Wrap<T>::type>() );
+		}
+		template<typename Predicate>
+		constexpr Vectorable Union( Vectorable second, Predicate predicate ) const
+		{
+			LINQINSTRUMENTIN( "Union", Count() + second.Count() )
+			StorageType ret( GetAllocator() );
+			auto sortedFirst = SortedBy( predicate );
+			auto sortedSecond = ::std::move( second ).SortedBy( predicate );
+			::std::set_union(
+				sortedFirst.CBegin(),
+				sortedFirst.CEnd(),
+				sortedSecond.CBegin(),
+				sortedSecond.CEnd(),
+				::std::back_inserter( ret ),
+				LINQCOUNTED( predicate ) );
+			LINQINSTRUMENTOUT( ret.size(), Details::CapacityBytes( ret ) )
+			return WithOrdering( Vectorable( ::std::move( ret ) ), Details::OrderingOf<Predicate, T>::value );
+		}
+		template<typename Hash, typename KeyEqual>
+		constexpr Vectorable Union( Vectorable second, Hash hash, KeyEqual equal ) const
+		{
+			LINQINSTRUMENTIN( "Union", Count() + second.Count() )
+			Details::FlatHashSet<typename Details::Wrap<T>::type, Hash, KeyEqual> set( hash, equal, Count() + second.Count() );
+			for( auto itr = CBegin(); itr != CEnd(); ++itr )
+			{
+				set.Insert( *itr );
+			}
+			for( auto itr = second.CBegin(); itr != second.CEnd(); ++itr )
+			{
+				set.Insert( *itr );
+			}
+			auto ret = Adopt( set.ReleaseKeys() );
+			LINQINSTRUMENTOUT( ret.Count(), Details::CapacityBytes( ret.data_ ) )
+			return ret;
+		}
+
+		constexpr Vectorable Intersect( Vectorable second ) const
+		{
+			if( order_ != Ordering::None && second.order_ == order_ )
+			{
+				return order_ == Ordering::Ascending ? SortedIntersect( second, ::std::less<>() ) : SortedIntersect( second, ::std::greater<>() );
+			}
+			return Intersect( ::std::move( second ), ::std::hash<typename Details::Wrap<T>::type>(), ::std::equal_to<typename Details::Wrap<T>::type>() );
+		}
+		template<typename Predicate>
+		constexpr Vectorable Intersect( Vectorable second, Predicate predicate ) const
+		{
+			LINQINSTRUMENTIN( "Intersect", Count() + second.Count() )
+			StorageType ret( GetAllocator() );
+			auto sortedFirst = SortedBy( predicate );
+			auto sortedSecond = ::std::move( second ).SortedBy( predicate );
+			::std::set_intersection(
+				sortedFirst.CBegin(),
+				sortedFirst.CEnd(),
+				sortedSecond.CBegin(),
+				sortedSecond.CEnd(),
+				::std::back_inserter( ret ),
+				LINQCOUNTED( predicate ) );
+			LINQINSTRUMENTOUT( ret.size(), Details::CapacityBytes( ret ) )
+			return WithOrdering( Vectorable( ::std::move( ret ) ), Details::OrderingOf<Predicate, T>::value );
+		}
+		template<typename Hash, typename KeyEqual>
+		constexpr Vectorable Intersect( Vectorable second, Hash hash, KeyEqual equal ) const
+		{
+			LINQINSTRUMENTIN( "Intersect", Count() + second.Count() )
+			Details::FlatHashSet<typename Details::Wrap<T>::type, Hash, KeyEqual> set( hash, equal, second.Count() );
+			for( auto itr = second.CBegin(); itr != second.CEnd(); ++itr )
+			{
+				set.Insert( *itr );
+			}
+
+			StorageType ret( GetAllocator() );
+			::std::vector<bool> taken( set.Count(), false );
+			for( auto itr = CBegin(); itr != CEnd(); ++itr )
+			{
+				const auto id = set.Find( *itr );
+				if( id != set.npos && !taken[id] )
+				{
+					taken[id] = true;
+					ret.push_back( *itr );
+				}
+			}
+			LINQINSTRUMENTOUT( ret.size(), Details::CapacityBytes( ret ) )
+			return WithOrdering( Vectorable( ::std::move( ret ) ), order_ );
+		}
+
+		// The elements of this which are not in second, then the elements of second which are not in this.
+		constexpr Vectorable SymmetricDiffer( Vectorable second ) const
+		{
+			return SymmetricDiffer( ::std::move( second ), ::std::hash<typename Details::Wrap<T>::type>(), ::std::equal_to<typename Details::Wrap<T>::type>() );
+		}
+		template<typename Hash, typename KeyEqual>
+		constexpr Vectorable SymmetricDiffer( Vectorable second, Hash hash, KeyEqual equal ) const
+		{
+			LINQINSTRUMENTIN( "SymmetricDiffer", Count() + second.Count() )
+			Details::FlatHashSet<typename Details::Wrap<T>::type, Hash, KeyEqual> firstSet( hash, equal, Count() );
+			for( auto itr = CBegin(); itr != CEnd(); ++itr )
+			{
+				firstSet.Insert( *itr );
+			}
+			Details::FlatHashSet<typename Details::Wrap<T>::type, Hash, KeyEqual> secondSet( hash, equal, second.Count() );
+			for( auto itr = second.CBegin(); itr != second.CEnd(); ++itr )
+			{
+				secondSet.Insert( *itr );
+			}
+
+			StorageType ret( GetAllocator() );
+			for( const auto& key : firstSet.Keys() )
+			{
+				if( secondSet.Find( key ) == secondSet.npos )
+				{
+					ret.push_back( key );
+				}
+			}
+			for( const auto& key : secondSet.Keys() )
+			{
+				if( firstSet.Find( key ) == firstSet.npos )
+				{
+					ret.push_back( key );
+				}
+			}
+			LINQINSTRUMENTOUT( ret.size(), Details::CapacityBytes( ret ) )
+			return Vectorable( ::std::move( ret ) );
+		}
+
+#pragma endregion
+
+#pragma region Conversion
+
+#ifdef __cplusplus_winrt
+		template<typename S>
+		constexpr RebindType<S> Cast() const
+		{
+			return Cast<S>( ::std::integral_constant<bool, __is_valid_winrt_type( T ) && !::std::is_arithmetic<T>::value>() );
+		}
+
+		template<typename S>
+		constexpr RebindType<S> Cast( ::std::false_type ) const
+		{
+			return Select<S>( []( T value ) { return static_cast<S>( value ); } );
+		}
+
+		template<typename S>
+		constexpr RebindType<S> Cast( ::std::true_type ) const
+		{
+			static_assert( __is_valid_winrt_type( typename Details::Wrap<T>::type ), "T is winrt type only." );
+
+			return Select<S>( []( T value ) { return dynamic_cast<S>( value ); } );
+		}
+#else
+		template<typename S>
+		constexpr RebindType<S> Cast() const
+		{
+			return Select<S>( []( T value ) { return static_cast<S>( value ); } );
+		}
+#endif
+
+		constexpr Vectorable Square() const
+		{
+			ARITHMETICABLECHECK
+
+			return Select( Details::Power2<T> );
+		}
+
+		template<typename S = void, typename Selector, typename R = Details::SelectResultT<S, Selector, T>>
+		constexpr RebindType<R> Select( Selector selector ) const &
+		{
+			LINQINSTRUMENT( "Select" )
+			RebindType<R> ret( Count(), RebindAllocator<R>() );
+			::std::transform(
+				CBegin(),
+				CEnd(),
+				ret.Begin(),
+				[&]( typename Details::Wrap<T>::type value ) { return Details::MakeWrap( static_cast<R>( LINQCOUNTED( selector )( Details::Unwrap( value ) ) ) ); } );
+			LINQINSTRUMENTOUT( ret.Count(), Details::CapacityBytes( ret.data_ ) )
+			return ret;
+		}
+		// A selector to the same type transforms the buffer of a temporary in place.
+		template<typename S = void, typename Selector, typename R = Details::SelectResultT<S, Selector, T>>
+		constexpr RebindType<R> Select( Selector selector ) &&
+		{
+			return ::std::move( *this ).template SelectInPlace<R>( selector, ::std::integral_constant<bool, ::std::is_same<RebindType<R>, Vectorable>::value>() );
+		}
+
+#pragma endregion
+
+#pragma region Vectorlize/Maplize
+
+#if defined( _VECTOR_ ) || defined( _LIBCPP_VECTOR ) || defined( _STLP_VECTOR ) || defined( _GLIBCXX_VECTOR )
+		constexpr ::std::vector<T> to_vector() const
+		{
+			::std::vector<T> ret( Count() );
+			::std::transform(
+				CBegin(),
+				CEnd(),
+				::std::begin( ret ),
+				[]( typename Details::Wrap<T>::type value ) { return Details::Unwrap( value ); } );
+			return ret;
+		}
+		template<typename S = void, typename Selector, typename R = Details::SelectResultT<S, Selector, T>> constexpr ::std::vector<R> to_vector( Selector selector ) const { return Select<R>( selector ).to_vector(); }
+#endif
+
+#if defined( _DEQUE_ ) || defined( _LIBCPP_DEQUE ) || defined( _STLP_DEQUE ) || defined( _GLIBCXX_DEQUE )
+		constexpr ::std::deque<T> to_deque() const
+		{
+			::std::deque<T> ret( Count() );
+			::std::transform(
+				CBegin(),
+				CEnd(),
+				::std::begin( ret ),
+				[]( typename Details::Wrap<T>::type value ) { return Details::Unwrap( value ); } );
+			return ret;
+		}
+		template<typename S = void, typename Selector, typename R = Details::SelectResultT<S, Selector, T>> constexpr ::std::deque<R> to_deque( Selector selector ) const { return Select<R>( selector ).to_deque(); }
+#endif
+
+#if defined( _LIST_ ) || defined( _LIBCPP_LIST ) || defined( _STLP_LIST ) || defined( _GLIBCXX_LIST )
+		constexpr ::std::list<T> to_list() const
+		{
+			::std::list<T> ret( Count() );
+			::std::transform(
+				CBegin(),
+				CEnd(),
+				::std::begin( ret ),
+				[]( typename Details::Wrap<T>::type value ) { return Details::Unwrap( value ); } );
+			return ret;
+		}
+		template<typename S = void, typename Selector, typename R = Details::SelectResultT<S, Selector, T>> constexpr ::std::list<R> to_list( Selector selector ) const { return Select<R>( selector ).to_list(); }
+#endif
+
+#if defined( _FORWARD_LIST_ ) || defined( _LIBCPP_FORWARD_LIST ) || defined( _STLP_FORWARD_LIST ) || defined( _GLIBCXX_FORWARD_LIST )
+		constexpr ::std::forward_list<T> to_forward_list() const
+		{
+			::std::forward_list<T> ret( Count() );
+			::std::transform(
+				CBegin(),
+				CEnd(),
+				::std::begin( ret ),
+				[]( typename Details::Wrap<T>::type value ) { return Details::Unwrap( value ); } );
+			return ret;
+		}
+		template<typename S = void, typename Selector, typename R = Details::SelectResultT<S, Selector, T>> constexpr ::std::forward_list<R> to_forward_list( Selector selector ) const { return Select<R>( selector ).to_forward_list(); }
+#endif
+
+#if defined( _MAP_ ) || defined( _LIBCPP_MAP ) || defined( _STLP_MAP ) || defined( _GLIBCXX_MAP )
+		template<typename SKey = void, typename Selector, typename Key = Details::SelectResultT<SKey, Selector, T>>
+		inline ::std::map<Key, T> to_map( Selector selector ) const
+		{
+			::std::map<Key, T> ret;
+			::std::for_each(
+				CBegin(),
+				CEnd(),
+				[&ret, selector]( typename Details::Wrap<T>::type value )
+				{
+					auto unwarppedValue = Details::Unwrap( value );
+					ret.emplace( selector( unwarppedValue ), unwarppedValue );
+				} );
+			return ret;
+		}
+		template<typename SKey = void, typename SValue = void, typename KeySelector, typename ValueSelector, typename Key = Details::SelectResultT<SKey, KeySelector, T>, typename Value = Details::SelectResultT<SValue, ValueSelector, T>>
+		inline ::std::map<Key, Value> to_map( KeySelector keySelector, ValueSelector valueSelector ) const
+		{
+			::std::map<Key, Value> ret;
+			::std::for_each(
+				CBegin(),
+				CEnd(),
+				[&ret, keySelector, valueSelector]( typename Details::Wrap<T>::type value )
+				{
+					auto unwarppedValue = Details::Unwrap( value );
+					ret.emplace( keySelector( unwarppedValue ), valueSelector( unwarppedValue ) );
+				} );
+			return ret;
+		}
+
+		template<typename SKey = void, typename Selector, typename Key = Details::SelectResultT<SKey, Selector, T>>
+		inline ::std::multimap<Key, T> to_multimap( Selector selector ) const
+		{
+			::std::multimap<Key, T> ret;
+			::std::for_each(
+				CBegin(),
+				CEnd(),
+				[&ret, selector]( typename Details::Wrap<T>::type value )
+				{
+					auto unwarppedValue = Details::Unwrap( value );
+					ret.emplace( selector( unwarppedValue ), unwarppedValue );
+				} );
+			return ret;
+		}
+		template<typename SKey = void, typename SValue = void, typename KeySelector, typename ValueSelector, typename Key = Details::SelectResultT<SKey, KeySelector, T>, typename Value = Details::SelectResultT<SValue, ValueSelector, T>>
+		inline ::std::multimap<Key, Value> to_multimap( KeySelector keySelector, ValueSelector valueSelector ) const
+		{
+			::std::multimap<Key, Value> ret;
+			::std::for_each(
+				CBegin(),
+				CEnd(),
+				[&ret, keySelector, valueSelector]( typename Details::Wrap<T>::type value )
+				{
+					auto unwarppedValue = Details::Unwrap( value );
+					ret.emplace( keySelector( unwarppedValue ), valueSelector( unwarppedValue ) );
+				} );
+			return ret;
+		}
+#endif
+
+#if defined( _UNORDERED_MAP_ ) || defined(  _LIBCPP_UNORDERED_MAP ) || defined( _STLP_UNORDERED_MAP ) || defined( _GLIBCXX_UNORDERED_MAP )
+		template<typename SKey = void, typename Selector, typename Key = Details::SelectResultT<SKey, Selector, T>>
+		constexpr ::std::unordered_map<Key, T> to_unordered_map( Selector selector ) const
+		{
+			::std::unordered_map<Key, T> ret;
+			::std::for_each(
+				CBegin(),
+				CEnd(),
+				[&ret, selector]( typename Details::Wrap<T>::type value )
+				{
+					auto unwarppedValue = Details::Unwrap( value );
+					ret.emplace( selector( unwarppedValue ), unwarppedValue );
+				} );
+			return ret;
+		}
+		template<typename SKey = void, typename SValue = void, typename KeySelector, typename ValueSelector, typename Key = Details::SelectResultT<SKey, KeySelector, T>, typename Value = Details::SelectResultT<SValue, ValueSelector, T>>
+		constexpr::std::unordered_map<Key, Value> to_unordered_map( KeySelector keySelector, ValueSelector valueSelector ) const
+		{
+			::std::unordered_map<Key, Value> ret;
+			::std::for_each(
+				CBegin(),
+				CEnd(),
+				[&ret, keySelector, valueSelector]( typename Details::Wrap<T>::type value )
+				{
+					auto unwarppedValue = Details::Unwrap( value );
+					ret.emplace( keySelector( unwarppedValue ), valueSelector( unwarppedValue ) );
+				} );
+			return ret;
+		}
+
+		template<typename SKey = void, typename Selector, typename Key = Details::SelectResultT<SKey, Selector, T>>
+		constexpr ::std::unordered_multimap<Key, T> to_unordered_multimap( Selector selector ) const
+		{
+			::std::unordered_multimap<Key, T> ret;
+			::std::for_each(
+				CBegin(),
+				CEnd(),
+				[&ret, selector]( typename Details::Wrap<T>::type value )
+				{
+					auto unwarppedValue = Details::Unwrap( value );
+					ret.emplace( selector( unwarppedValue ), unwarppedValue );
+				} );
+			return ret;
+		}
+		template<typename SKey = void, typename SValue = void, typename KeySelector, typename ValueSelector, typename Key = Details::SelectResultT<SKey, KeySelector, T>, typename Value = Details::SelectResultT<SValue, ValueSelector, T>>
+		constexpr::std::unordered_multimap<Key, Value> to_unordered_multimap( KeySelector keySelector, ValueSelector valueSelector ) const
+		{
+			::std::unordered_multimap<Key, Value> ret;
+			::std::for_each(
+				CBegin(),
+				CEnd(),
+				[&ret, keySelector, valueSelector]( typename Details::Wrap<T>::type value )
+				{
+					auto unwarppedValue = Details::Unwrap( value );
+					ret.emplace( keySelector( unwarppedValue ), valueSelector( unwarppedValue ) );
+				} );
+			return ret;
+		}
+#endif
+
+#ifdef _COLLECTION_H_
+		constexpr ::Windows::Foundation::Collections::IVector<T>^ ToVector() const
+		{
+			return ref new ::Platform::Collections::Vector<T>( ::std::move( to_vector() ) );
+		}
+		template<typename S = void, typename Selector, typename R = Details::SelectResultT<S, Selector, T>> constexpr ::Windows::Foundation::Collections::IVector<R>^ ToVector( Selector selector ) const { return Select<R>( selector ).ToVector(); }
+
+		constexpr ::Windows::Foundation::Collections::IVectorView<T>^ ToVectorView() const
+		{
+			return ref new ::Platform::Collections::VectorView<T>( ::std::move( to_vector() ) );
+		}
+		template<typename S = void, typename Selector, typename R = Details::SelectResultT<S, Selector, T>> constexpr ::Windows::Foundation::Collections::IVectorView<R>^ ToVectorView( Selector selector ) const { return Select<R>( selector ).ToVectorView(); }
+
+#ifdef VECTOR_EXTENSION
+		constexpr::Windows::Foundation::Collections::IVector<T>^ ToDeque() const
+		{
+			return ref new ::Platform::Collections::Vector<T>( ::std::move( to_deque() ) );
+		}
+		template<typename S = void, typename Selector, typename R = Details::SelectResultT<S, Selector, T>> constexpr ::Windows::Foundation::Collections::IVector<R>^ ToDeque( Selector selector ) const { return Select<R>( selector ).ToDeque(); }
+
+		constexpr::Windows::Foundation::Collections::IVectorView<T>^ ToDequeView() const
+		{
+			return ref new ::Platform::Collections::VectorView<T>( ::std::move( to_deque() ) );
+		}
+		template<typename S = void, typename Selector, typename R = Details::SelectResultT<S, Selector, T>> constexpr ::Windows::Foundation::Collections::IVectorView<R>^ ToDequeView( Selector selector ) const { return Select<R>( selector ).ToDequeView(); }
+#endif
+
+		template<typename SKey = void, typename Selector, typename Key = Details::SelectResultT<SKey, Selector, T>>
+		constexpr ::Windows::Foundation::Collections::IMap<Key, T>^ ToMap( Selector selector ) const
+		{
+			return ref new ::Platform::Collections::Map<Key, T>( ::std::move( to_map( selector ) ) );
+		}
+
+		template<typename SKey = void, typename SValue = void, typename KeySelector, typename ValueSelector, typename Key = Details::SelectResultT<SKey, KeySelector, T>, typename Value = Details::SelectResultT<SValue, ValueSelector, T>>
+		constexpr ::Windows::Foundation::Collections::IMap<Key, Value>^ ToMap( KeySelector keySelector, ValueSelector valueSelector ) const
+		{
+			return ref new ::Platform::Collections::Map<Key, Value>( ::std::move( to_map( keySelector, valueSelector ) ) );
+		}
+
+		template<typename SKey = void, typename Selector, typename Key = Details::SelectResultT<SKey, Selector, T>>
+		constexpr ::Windows::Foundation::Collections::IMapView<Key, T>^ ToMapView( Selector selector ) const
+		{
+			return ref new ::Platform::Collections::MapView<Key, T>( ::std::move( to_map( selector ) ) );
+		}
+
+		template<typename SKey = void, typename SValue = void, typename KeySelector, typename ValueSelector, typename Key = Details::SelectResultT<SKey, KeySelector, T>, typename Value = Details::SelectResultT<SValue, ValueSelector, T>>
+		constexpr ::Windows::Foundation::Collections::IMapView<Key, Value>^ ToMapView( KeySelector keySelector, ValueSelector valueSelector ) const
+		{
+			return ref new ::Platform::Collections::MapView<Key, Value>( ::std::move( to_map( keySelector, valueSelector ) ) );
+		}
+
+		template<typename SKey = void, typename Selector, typename Key = Details::SelectResultT<SKey, Selector, T>>
+		constexpr ::Windows::Foundation::Collections::IMap<Key, T>^ ToUnorderedMap( Selector selector ) const
+		{
+			return ref new ::Platform::Collections::UnorderedMap<Key, T>( ::std::move( to_unordered_map( selector ) ) );
+		}
+
+		template<typename SKey = void, typename SValue = void, typename KeySelector, typename ValueSelector, typename Key = Details::SelectResultT<SKey, KeySelector, T>, typename Value = Details::SelectResultT<SValue, ValueSelector, T>>
+		constexpr ::Windows::Foundation::Collections::IMap<Key, Value>^ ToUnorderedMap( KeySelector keySelector, ValueSelector valueSelector ) const
+		{
+			return ref new ::Platform::Collections::UnorderedMap<Key, Value>( ::std::move( to_unordered_map( keySelector, valueSelector ) ) );
+		}
+
+		template<typename SKey = void, typename Selector, typename Key = Details::SelectResultT<SKey, Selector, T>>
+		constexpr ::Windows::Foundation::Collections::IMapView<Key, T>^ ToUnorderedMapView( Selector selector ) const
+		{
+			return ref new ::Platform::Collections::UnorderedMapView<Key, T>( ::std::move( to_unordered_map( selector ) ) );
+		}
+
+		template<typename SKey = void, typename SValue = void, typename KeySelector, typename ValueSelector, typename Key = Details::SelectResultT<SKey, KeySelector, T>, typename Value = Details::SelectResultT<SValue, ValueSelector, T>>
+		constexpr ::Windows::Foundation::Collections::IMapView<Key, Value>^ ToUnorderedMapView( KeySelector keySelector, ValueSelector valueSelector ) const
+		{
+			return ref new ::Platform::Collections::UnorderedMapView<Key, Value>( ::std::move( to_unordered_map( keySelector, valueSelector ) ) );
+		}
+#endif
+
+#pragma endregion
+
+#pragma region Grouping
+
+		// GroupBy borrows this Vectorable's elements like AsParallel, so the result must not outlive an owning Vectorable.
+		template<typename KeySelector, typename ElementSelector = Details::Identity>
+		constexpr auto GroupBy( KeySelector keySelector, ElementSelector elementSelector = ElementSelector() ) const &
+		{
+			using Key = ::std::decay_t<Details::InvokeResultT<KeySelector, T>>;
+			return GroupBy( keySelector, elementSelector, ::std::hash<Key>(), ::std::equal_to<Key>() );
+		}
+		template<typename KeySelector, typename ElementSelector = Details::Identity>
+		constexpr auto GroupBy( KeySelector keySelector, ElementSelector elementSelector = ElementSelector() ) &&
+		{
+			using Key = ::std::decay_t<Details::InvokeResultT<KeySelector, T>>;
+			return ::std::move( *this ).GroupBy( keySelector, elementSelector, ::std::hash<Key>(), ::std::equal_to<Key>() );
+		}
+		template<typename KeySelector, typename ElementSelector, typename Hash, typename KeyEqual>
+		constexpr GroupedVectorable<T, KeySelector, ElementSelector, Hash, KeyEqual> GroupBy( KeySelector keySelector, ElementSelector elementSelector, Hash hash, KeyEqual equal ) const &
+		{
+			return GroupedVectorable<T, KeySelector, ElementSelector, Hash, KeyEqual>( Vectorable<T>( CBegin(), Count(), Details::BorrowTag() ), keySelector, elementSelector, hash, equal );
+		}
+		template<typename KeySelector, typename ElementSelector, typename Hash, typename KeyEqual>
+		constexpr GroupedVectorable<T, KeySelector, ElementSelector, Hash, KeyEqual> GroupBy( KeySelector keySelector, ElementSelector elementSelector, Hash hash, KeyEqual equal ) &&
+		{
+			return GroupedVectorable<T, KeySelector, ElementSelector, Hash, KeyEqual>( ::std::move( *this ).Release(), keySelector, elementSelector, hash, equal );
+		}
+
+		template<typename KeySelector, typename ElementSelector = Details::Identity>
+		constexpr auto ToLookup( KeySelector keySelector, ElementSelector elementSelector = ElementSelector() ) const
+		{
+			return GroupBy( keySelector, elementSelector ).ToLookup();
+		}
+		template<typename KeySelector, typename ElementSelector, typename Hash, typename KeyEqual>
+		constexpr auto ToLookup( KeySelector keySelector, ElementSelector elementSelector, Hash hash, KeyEqual equal ) const
+		{
+			return GroupBy( keySelector, elementSelector, hash, equal ).ToLookup();
+		}
+
+#pragma endregion
+
+#pragma region Join
+
+		// Equi-joins like .NET LINQ: the results are in the order of this (outer) sequence, and for each outer element
+		// in the order of the inner sequence. The hash table is built on the smaller side.
+		template<typename S = void, typename U, typename UAllocator, typename OuterKeySelector, typename InnerKeySelector, typename ResultSelector, typename R = Details::SelectResultT<S, ResultSelector, T, U>>
+		constexpr RebindType<R> Join( const Vectorable<U, UAllocator>& inner, OuterKeySelector outerKeySelector, InnerKeySelector innerKeySelector, ResultSelector resultSelector ) const
+		{
+			using Key = ::std::decay_t<Details::InvokeResultT<OuterKeySelector, T>>;
+			return Join<S>( inner, outerKeySelector, innerKeySelector, resultSelector, ::std::hash<Key>(), ::std::equal_to<Key>() );
+		}
+		template<typename S = void, typename U, typename UAllocator, typename OuterKeySelector, typename InnerKeySelector, typename ResultSelector, typename Hash, typename KeyEqual, typename R = Details::SelectResultT<S, ResultSelector, T, U>>
+		constexpr RebindType<R> Join( const Vectorable<U, UAllocator>& inner, OuterKeySelector outerKeySelector, InnerKeySelector innerKeySelector, ResultSelector resultSelector, Hash hash, KeyEqual equal ) const
+		{
+			LINQINSTRUMENTIN( "Join", Count() + inner.Count() )
+			const auto index = JoinIndex( inner, outerKeySelector, innerKeySelector, hash, equal );
+			const auto outer = CBegin();
+			const auto innerFirst = inner.CBegin();
+
+			typename RebindType<R>::StorageType ret( RebindAllocator<R>() );
+			ret.reserve( index.innerIndices.size() );
+			for( SizeType i = 0; i < Count(); ++i )
+			{
+				const auto id = index.outerIds[i];
+				if( id == index.npos )
+				{
+					continue;
+				}
+				for( auto k = index.offsets[id]; k < index.offsets[id + 1]; ++k )
+				{
+					ret.push_back( Details::MakeWrap( static_cast<R>( LINQCOUNTED( resultSelector )( Details::Unwrap( outer[i] ), Details::Unwrap( innerFirst[index.innerIndices[k]] ) ) ) ) );
+				}
+			}
+			LINQINSTRUMENTOUT( ret.size(), Details::CapacityBytes( ret ) )
+			return RebindType<R>( ::std::move( ret ) );
+		}
+
+		// resultSelector( outer, group ) is called once per outer element with the matching inner elements, possibly none.
+		// The group borrows a buffer which only lives during the call.
+		template<typename S = void, typename U, typename UAllocator, typename OuterKeySelector, typename InnerKeySelector, typename ResultSelector, typename R = Details::SelectResultT<S, ResultSelector, T, const Vectorable<U>&>>
+		constexpr RebindType<R> GroupJoin( const Vectorable<U, UAllocator>& inner, OuterKeySelector outerKeySelector, InnerKeySelector innerKeySelector, ResultSelector resultSelector ) const
+		{
+			using Key = ::std::decay_t<Details::InvokeResultT<OuterKeySelector, T>>;
+			return GroupJoin<S>( inner, outerKeySelector, innerKeySelector, resultSelector, ::std::hash<Key>(), ::std::equal_to<Key>() );
+		}
+		template<typename S = void, typename U, typename UAllocator, typename OuterKeySelector, typename InnerKeySelector, typename ResultSelector, typename Hash, typename KeyEqual, typename R = Details::SelectResultT<S, ResultSelector, T, const Vectorable<U>&>>
+		constexpr RebindType<R> GroupJoin( const Vectorable<U, UAllocator>& inner, OuterKeySelector outerKeySelector, InnerKeySelector innerKeySelector, ResultSelector resultSelector, Hash hash, KeyEqual equal ) const
+		{
+			LINQINSTRUMENTIN( "GroupJoin", Count() + inner.Count() )
+			const auto index = JoinIndex( inner, outerKeySelector, innerKeySelector, hash, equal );
+			const auto outer = CBegin();
+			const auto innerFirst = inner.CBegin();
+
+			// The matching inner elements, stored contiguously per key.
+			::std::vector<typename Details::Wrap<U>::type> groups;
+			groups.reserve( index.innerIndices.size() );
+			for( const auto j : index.innerIndices )
+			{
+				groups.push_back( innerFirst[j] );
+			}
+
+			typename RebindType<R>::StorageType ret( RebindAllocator<R>() );
+			ret.reserve( Count() );
+			for( SizeType i = 0; i < Count(); ++i )
+			{
+				const auto id = index.outerIds[i];
+				const auto group = id != index.npos
+					? Vectorable<U>( groups.data() + index.offsets[id], index.offsets[id + 1] - index.offsets[id], Details::BorrowTag() )
+					: Vectorable<U>( 0 );
+				ret.push_back( Details::MakeWrap( static_cast<R>( LINQCOUNTED( resultSelector )( Details::Unwrap( outer[i] ), group ) ) ) );
+			}
+			LINQINSTRUMENTOUT( ret.size(), Details::CapacityBytes( ret ) + Details::CapacityBytes( groups ) )
+			return RebindType<R>( ::std::move( ret ) );
+		}
+
+		// Sort-merge join for inputs which are both sorted by their keys in the order of predicate (default: operator<).
+		// No hash table: one pass over each side, and the results are in the same order as Join.
+		template<typename S = void, typename U, typename UAllocator, typename OuterKeySelector, typename InnerKeySelector, typename ResultSelector, typename R = Details::SelectResultT<S, ResultSelector, T, U>>
+		constexpr RebindType<R> MergeJoin( const Vectorable<U, UAllocator>& inner, OuterKeySelector outerKeySelector, InnerKeySelector innerKeySelector, ResultSelector resultSelector ) const
+		{
+			return MergeJoin<S>( inner, outerKeySelector, innerKeySelector, resultSelector, ::std::less<>() );
+		}
+		template<typename S = void, typename U, typename UAllocator, typename OuterKeySelector, typename InnerKeySelector, typename ResultSelector, typename Predicate, typename R = Details::SelectResultT<S, ResultSelector, T, U>>
+		constexpr RebindType<R> MergeJoin( const Vectorable<U, UAllocator>& inner, OuterKeySelector outerKeySelector, InnerKeySelector innerKeySelector, ResultSelector resultSelector, Predicate predicate ) const
+		{
+			LINQINSTRUMENTIN( "MergeJoin", Count() + inner.Count() )
+			const auto outer = CBegin();
+			const auto innerFirst = inner.CBegin();
+			const auto outerCount = Count();
+			const auto innerCount = inner.Count();
+
+			typename RebindType<R>::StorageType ret( RebindAllocator<R>() );
+			SizeType i = 0, j = 0;
+			while( i < outerCount && j < innerCount )
+			{
+				const auto outerKey = outerKeySelector( Details::Unwrap( outer[i] ) );
+				const auto innerKey = innerKeySelector( Details::Unwrap( innerFirst[j] ) );
+				if( predicate( outerKey, innerKey ) )
+				{
+					++i;
+				}
+				else if( predicate( innerKey, outerKey ) )
+				{
+					++j;
+				}
+				else
+				{
+					// Equal keys: the cross product of the two runs.
+					auto innerEnd = j + 1;
+					while( innerEnd < innerCount && !predicate( outerKey, innerKeySelector( Details::Unwrap( innerFirst[innerEnd] ) ) ) )
+					{
+						++innerEnd;
+					}
+					do
+					{
+						for( auto k = j; k < innerEnd; ++k )
+						{
+							ret.push_back( Details::MakeWrap( static_cast<R>( LINQCOUNTED( resultSelector )( Details::Unwrap( outer[i] ), Details::Unwrap( innerFirst[k] ) ) ) ) );
+						}
+						++i;
+					} while( i < outerCount && !predicate( innerKey, outerKeySelector( Details::Unwrap( outer[i] ) ) ) );
+					j = innerEnd;
+				}
+			}
+			LINQINSTRUMENTOUT( ret.size(), Details::CapacityBytes( ret ) )
+			return RebindType<R>( ::std::move( ret ) );
+		}
+
+#pragma endregion
+
+#pragma region File
+
+		// Writes a snapshot: a Details::SnapshotHeader (element size, count and checksum) followed by the elements.
+		// Linq::FromSnapshot maps it back without parsing or copying.
+		inline void to_file( const ::std::string& path ) const
+		{
+			static_assert( ::std::is_trivially_copyable<T>::value, "T must be trivially copyable." );
+
+			const auto size = Count() * sizeof( T );
+			Details::SnapshotHeader header = { };
+			::std::memcpy( header.magic, Details::SnapshotMagic, sizeof( header.magic ) );
+			header.version = Details::SnapshotVersion;
+			header.elementSize = static_cast<::std::uint32_t>( sizeof( T ) );
+			header.count = static_cast<::std::uint64_t>( Count() );
+			header.checksum = Details::Checksum( CBegin(), size );
+
+			::std::ofstream file( path, ::std::ios::binary | ::std::ios::trunc );
+			file.write( reinterpret_cast<const char*>( &header ), sizeof( header ) );
+			file.write( reinterpret_cast<const char*>( CBegin() ), static_cast<::std::streamsize>( size ) );
+			file.close();
+			if( !file )
+			{
+				throw ::std::runtime_error( path + ": cannot write the snapshot." );
+			}
+		}
+
+#pragma endregion
+
+#pragma region Deferred Execution
+
+		constexpr Enumerable<T, Details::PointerEnumerator<typename Details::Wrap<T>::type>> AsEnumerable() const &
+		{
+			return Enumerable<T, Details::PointerEnumerator<typename Details::Wrap<T>::type>>(
+				Details::PointerEnumerator<typename Details::Wrap<T>::type>( CBegin(), CEnd(), owner_ ) );
+		}
+		inline Enumerable<T, Details::PointerEnumerator<typename Details::Wrap<T>::type>> AsEnumerable() &&
+		{
+			if( IsBorrowed() )
+			{
+				return static_cast<const Vectorable&>( *this ).AsEnumerable();
+			}
+
+			// A temporary gives its buffer to the enumerator, which keeps it alive.
+			auto owner = ::std::make_shared<const StorageType>( ::std::move( data_ ) );
+			return Enumerable<T, Details::PointerEnumerator<typename Details::Wrap<T>::type>>(
+				Details::PointerEnumerator<typename Details::Wrap<T>::type>( owner->data(), owner->data() + owner->size(), owner ) );
+		}
+
+#pragma endregion
+
+#pragma region Parallel Execution
+
+		// The parallel query borrows this Vectorable's elements, so it must not outlive an owning Vectorable.
+		constexpr ParallelVectorable<T> AsParallel() const & { return ParallelVectorable<T>( Vectorable<T>( CBegin(), Count(), owner_ ) ); }
+		constexpr ParallelVectorable<T> AsParallel() && { return ParallelVectorable<T>( ::std::move( *this ).Release() ); }
+
+#pragma endregion
+
+	private:
+		// Floating point: one pass of Stats, with the moments in double.
+		constexpr T Variance( ::std::true_type ) const
+		{
+			return static_cast<T>( Stats().Variance() );
+		}
+
+		// Integer: the mean is truncated and everything is computed in T.
+		constexpr T Variance( ::std::false_type ) const
+		{
+			const auto average = Average();
+			T ret = 0;
+			for( auto itr = CBegin(); itr != CEnd(); ++itr )
+			{
+				ret += Details::Power2( *itr - average );
+			}
+			return ret / static_cast<T>( Count() );
+		}
+
+		// For each outer element, the id of its key (or npos when nothing matches); for each id, a range of innerIndices
+		// with the matching inner elements in their order. The keys of the smaller side go into the hash table,
+		// and the larger side only probes it, so inner elements which match nothing are never stored.
+		struct JoinIndexType
+		{
+			static const SizeType npos = static_cast<SizeType>( -1 );
+
+			::std::vector<SizeType> outerIds;
+			::std::vector<SizeType> offsets;
+			::std::vector<SizeType> innerIndices;
+		};
+
+		template<typename U, typename UAllocator, typename OuterKeySelector, typename InnerKeySelector, typename Hash, typename KeyEqual>
+		constexpr JoinIndexType JoinIndex( const Vectorable<U, UAllocator>& inner, OuterKeySelector& outerKeySelector, InnerKeySelector& innerKeySelector, Hash hash, KeyEqual equal ) const
+		{
+			using Key = ::std::decay_t<Details::InvokeResultT<OuterKeySelector, T>>;
+
+			const auto outer = CBegin();
+			const auto innerFirst = inner.CBegin();
+			const auto outerCount = Count();
+			const auto innerCount = inner.Count();
+
+			JoinIndexType ret;
+			ret.outerIds.resize( outerCount );
+			::std::vector<SizeType> innerIds( innerCount );
+			Details::FlatHashSet<Key, Hash, KeyEqual> keys( hash, equal, ::std::min( outerCount, innerCount ) );
+			if( innerCount <= outerCount )
+			{
+				for( SizeType j = 0; j < innerCount; ++j )
+				{
+					innerIds[j] = keys.Insert( static_cast<Key>( innerKeySelector( Details::Unwrap( innerFirst[j] ) ) ) ).first;
+				}
+				for( SizeType i = 0; i < outerCount; ++i )
+				{
+					ret.outerIds[i] = keys.Find( outerKeySelector( Details::Unwrap( outer[i] ) ) );
+				}
+			}
+			else
+			{
+				for( SizeType i = 0; i < outerCount; ++i )
+				{
+					ret.outerIds[i] = keys.Insert( outerKeySelector( Details::Unwrap( outer[i] ) ) ).first;
+				}
+				for( SizeType j = 0; j < innerCount; ++j )
+				{
+					innerIds[j] = keys.Find( static_cast<Key>( innerKeySelector( Details::Unwrap( innerFirst[j] ) ) ) );
+				}
+			}
+
+			ret.offsets.assign( keys.Count() + 1, 0 );
+			for( const auto id : innerIds )
+			{
+				if( id != ret.npos )
+				{
+					++ret.offsets[id + 1];
+				}
+			}
+			::std::partial_sum( ret.offsets.begin(), ret.offsets.end(), ret.offsets.begin() );
+
+			ret.innerIndices.resize( ret.offsets.back() );
+			auto cursors = ret.offsets;
+			for( SizeType j = 0; j < innerCount; ++j )
+			{
+				if( innerIds[j] != ret.npos )
+				{
+					ret.innerIndices[cursors[innerIds[j]]++] = j;
+				}
+			}
+			return ret;
+		}
+
+		template<typename U, typename UAllocator>
+		constexpr BivariateStatistics Bivariate( const Vectorable<U, UAllocator>& other ) const
+		{
+			ARITHMETICABLECHECK
+
+			if( other.Count() != Count() )
+			{
+				OUTOFRANGEEX
+			}
+
+			BivariateStatistics ret;
+			const auto y = other.CBegin();
+			for( SizeType i = 0; i < Count(); ++i )
+			{
+				ret.Add( static_cast<double>( CBegin()[i] ), static_cast<double>( y[i] ) );
+			}
+			return ret;
+		}
+
+		template<typename U>
+		constexpr Details::RebindAllocatorT<Allocator, U> RebindAllocator() const
+		{
+			return Details::RebindAllocatorT<Allocator, U>( data_.get_allocator() );
+		}
+
+		// The number of leading elements which satisfy predicate.
+		template<typename Predicate>
+		constexpr SizeType PrefixLength( Predicate& predicate, const char* name ) const
+		{
+			LINQINSTRUMENT( name )
 			SizeType i = 0;
-			for( ; i < size; ++i )
+			for( ; i < Count(); ++i )
+			{
+				const auto data = CBegin()[i];
+				if( !LINQCOUNTED( predicate )( data ) )
+				{
+					break;
+				}
+			}
+			LINQINSTRUMENTOUT( i, 0 )
+			return i;
+		}
+
+		// A borrowed buffer is copied first; the copy is recorded as the allocation of the sort.
+		template<typename Predicate>
+		constexpr Vectorable Sort( Predicate predicate ) &&
+		{
+			LINQINSTRUMENT( "OrderBy" )
+			LINQINSTRUMENTOUT( Count(), IsBorrowed() ? Count() * sizeof( typename StorageType::value_type ) : 0 )
+			Detach();
+			if( !IsOrderedBy<Predicate>() )
+			{
+				Details::Sort<Predicate>( data_.data(), data_.data() + data_.size(), LINQCOUNTED( predicate ) );
+				order_ = Details::OrderingOf<Predicate, T>::value;
+			}
+			return ::std::move( *this );
+		}
+
+		template<typename Predicate>
+		constexpr bool IsOrderedBy() const
+		{
+			return order_ != Ordering::None && order_ == Details::OrderingOf<Predicate, T>::value;
+		}
+
+		// This sorted by predicate for the sort based set operators: a borrowed view when it is already in that order.
+		template<typename Predicate>
+		constexpr Vectorable SortedBy( Predicate predicate ) const &
+		{
+			return IsOrderedBy<Predicate>() ? View() : OrderBy( predicate );
+		}
+		template<typename Predicate>
+		constexpr Vectorable SortedBy( Predicate predicate ) &&
+		{
+			return IsOrderedBy<Predicate>() ? ::std::move( *this ) : ::std::move( *this ).OrderBy( predicate );
+		}
+
+		// The distinct elements of this which are not in second, both sorted by comp.
+		template<typename Compare>
+		constexpr Vectorable SortedExcept( const Vectorable& second, Compare comp ) const
+		{
+			LINQINSTRUMENTIN( "Except", Count() + second.Count() )
+			StorageType ret( GetAllocator() );
+			auto found = second.CBegin();
+			for( auto itr = CBegin(); itr != CEnd(); ++itr )
+			{
+				if( itr != CBegin() && !comp( itr[-1], *itr ) )
+				{
+					continue;
+				}
+
+				found = Details::Gallop( found, second.CEnd(), *itr, comp );
+				if( found == second.CEnd() || comp( *itr, *found ) )
+				{
+					ret.push_back( *itr );
+				}
+			}
+			LINQINSTRUMENTOUT( ret.size(), Details::CapacityBytes( ret ) )
+			return WithOrdering( Vectorable( ::std::move( ret ) ), order_ );
+		}
+
+		// The distinct elements of this which are in second, both sorted by comp. The shorter one is walked and
+		// the longer one galloped through, so m elements against n cost O( m log( n / m ) ).
+		template<typename Compare>
+		constexpr Vectorable SortedIntersect( const Vectorable& second, Compare comp ) const
+		{
+			LINQINSTRUMENTIN( "Intersect", Count() + second.Count() )
+			const auto walkThis = Count() <= second.Count();
+			const auto& shorter = walkThis ? *this : second;
+			const auto& longer = walkThis ? second : *this;
+
+			StorageType ret( GetAllocator() );
+			auto found = longer.CBegin();
+			for( auto itr = shorter.CBegin(); itr != shorter.CEnd(); ++itr )
+			{
+				if( itr != shorter.CBegin() && !comp( itr[-1], *itr ) )
+				{
+					continue;
+				}
+
+				found = Details::Gallop( found, longer.CEnd(), *itr, comp );
+				if( found == longer.CEnd() )
+				{
+					break;
+				}
+				if( !comp( *itr, *found ) )
+				{
+					ret.push_back( walkThis ? *itr : *found );
+				}
+			}
+			LINQINSTRUMENTOUT( ret.size(), Details::CapacityBytes( ret ) )
+			return WithOrdering( Vectorable( ::std::move( ret ) ), order_ );
+		}
+
+		// The elements equal to value, by binary search in the known order.
+		constexpr ::std::pair<ConstItrType, ConstItrType> EqualRange( const T& value ) const
+		{
+			return order_ == Ordering::Ascending
+				? ::std::equal_range( CBegin(), CEnd(), value, ::std::less<>() )
+				: ::std::equal_range( CBegin(), CEnd(), value, ::std::greater<>() );
+		}
+
+		// A borrowed view of this in the same order, for the const & operators which sort a temporary.
+		constexpr Vectorable View() const
+		{
+			return WithOrdering( Vectorable( CBegin(), Count(), Details::BorrowTag(), GetAllocator() ), order_ );
+		}
+
+		static constexpr Vectorable WithOrdering( Vectorable ret, Ordering order )
+		{
+			ret.order_ = order;
+			return ret;
+		}
+
+		static constexpr Ordering Reversed( Ordering order )
+		{
+			return order == Ordering::Ascending ? Ordering::Descending : order == Ordering::Descending ? Ordering::Ascending : Ordering::None;
+		}
+
+		template<typename R, typename Selector>
+		constexpr Vectorable SelectInPlace( Selector& selector, ::std::true_type ) &&
+		{
+			if( IsBorrowed() )
+			{
+				return static_cast<const Vectorable&>( *this ).template Select<R>( selector );
+			}
+
+			LINQINSTRUMENT( "Select" )
+			::std::transform(
+				::std::begin( data_ ),
+				::std::end( data_ ),
+				::std::begin( data_ ),
+				[&]( typename Details::Wrap<T>::type value ) { return Details::MakeWrap( static_cast<R>( LINQCOUNTED( selector )( Details::Unwrap( value ) ) ) ); } );
+			order_ = Ordering::None;
+			LINQINSTRUMENTOUT( Count(), 0 )
+			return ::std::move( *this );
+		}
+		template<typename R, typename Selector>
+		constexpr RebindType<R> SelectInPlace( Selector& selector, ::std::false_type ) &&
+		{
+			return static_cast<const Vectorable&>( *this ).template Select<R>( selector );
+		}
+
+		constexpr RebindType<Vectorable> Windows( SizeType size, SizeType step, bool partial ) const
+		{
+			if( size == 0 || step == 0 )
+			{
+				OUTOFRANGEEX
+			}
+
+			LINQINSTRUMENT( partial ? "Chunk" : "Window" )
+			const auto count = Count();
+			const auto windowCount = partial ? ( count + size - 1 ) / size : ( count >= size ? ( count - size ) / step + 1 : 0 );
+			typename RebindType<Vectorable>::StorageType ret( RebindAllocator<Vectorable>() );
+			ret.reserve( windowCount );
+			for( SizeType i = 0; i < windowCount; ++i )
+			{
+				const auto begin = CBegin() + i * step;
+				ret.emplace_back( StorageType( begin, begin + ::std::min( size, count - i * step ), GetAllocator() ) );
+			}
+			LINQINSTRUMENTOUT( windowCount, Details::CapacityBytes( ret ) + ( partial ? count : windowCount * size ) * sizeof( typename StorageType::value_type ) )
+			return RebindType<Vectorable>( ::std::move( ret ) );
+		}
+
+		// The number of windows of size elements.
+		constexpr SizeType MovingCount( SizeType size ) const
+		{
+			if( size == 0 )
+			{
+				OUTOFRANGEEX
+			}
+
+			return Count() >= size ? Count() - size + 1 : 0;
+		}
+
+		// The sums of the windows, each divided by divisor, with the running sum in S.
+		template<typename S>
+		constexpr RebindType<S> MovingSum( SizeType size, SizeType divisor ) const
+		{
+			RebindType<S> ret( MovingCount( size ), RebindAllocator<S>() );
+			const auto first = CBegin();
+			S sum = 0;
+			for( SizeType i = 0; i < ret.Count(); ++i )
+			{
+				// A floating point sum is started again every size windows, so the rounding errors of the updates do not add up.
+				if( i == 0 || ( ::std::is_floating_point<S>::value && i % size == 0 ) )
+				{
+					sum = ::std::accumulate( first + i, first + i + size, static_cast<S>( 0 ), []( S x, T y ) { return x + static_cast<S>( y ); } );
+				}
+				else
+				{
+					sum += static_cast<S>( first[i + size - 1] ) - static_cast<S>( first[i - 1] );
+				}
+				ret.data_[i] = sum / static_cast<S>( divisor );
+			}
+			return ret;
+		}
+
+		// comp( x, y ) when x wins over y. The deque holds the indices of the window which can still be its winner,
+		// with their values in comp order, so its front is the winner and every index is pushed and popped once.
+		template<typename Compare>
+		constexpr Vectorable MovingExtreme( SizeType size, Compare comp ) const
+		{
+			Vectorable ret( MovingCount( size ), GetAllocator() );
+			if( ret.Empty() )
+			{
+				return ret;
+			}
+
+			const auto first = CBegin();
+			::std::deque<SizeType> candidates;
+			for( SizeType i = 0; i < ret.Count() + size - 1; ++i )
+			{
+				while( !candidates.empty() && !comp( first[candidates.back()], first[i] ) )
+				{
+					candidates.pop_back();
+				}
+				candidates.push_back( i );
+				if( i + 1 >= size )
+				{
+					if( candidates.front() + size <= i )
+					{
+						candidates.pop_front();
+					}
+					ret.data_[i + 1 - size] = first[candidates.front()];
+				}
+			}
+			return ret;
+		}
+
+		// The hash based operators collect their keys in a ::std::vector with the default allocator.
+		constexpr Vectorable Adopt( ::std::vector<typename Details::Wrap<T>::type>&& values ) const
+		{
+			return Adopt( ::std::move( values ), ::std::is_same<StorageType, ::std::vector<typename Details::Wrap<T>::type>>() );
+		}
+		constexpr Vectorable Adopt( ::std::vector<typename Details::Wrap<T>::type>&& values, ::std::true_type ) const
+		{
+			return Vectorable( ::std::move( values ) );
+		}
+		constexpr Vectorable Adopt( ::std::vector<typename Details::Wrap<T>::type>&& values, ::std::false_type ) const
+		{
+			return Vectorable( ::std::begin( values ), ::std::end( values ), GetAllocator() );
+		}
+
+		// The grouping and parallel engines hold a Vectorable<T>: another allocator's buffer is copied into the default one.
+		constexpr Vectorable<T> Release() &&
+		{
+			return ::std::move( *this ).Release( ::std::is_same<Vectorable, Vectorable<T>>() );
+		}
+		constexpr Vectorable<T> Release( ::std::true_type ) &&
+		{
+			return ::std::move( *this );
+		}
+		constexpr Vectorable<T> Release( ::std::false_type ) &&
+		{
+			return IsBorrowed() ? Vectorable<T>( CBegin(), Count(), owner_ ) : Vectorable<T>( CBegin(), CEnd() );
+		}
+
+		constexpr void Detach()
+		{
+			if( view_ != nullptr )
+			{
+				data_.assign( view_, view_ + viewSize_ );
+				view_ = nullptr;
+				viewSize_ = 0;
+				owner_.reset();
+			}
+		}
+
+		StorageType data_;
+		ConstItrType view_;
+		SizeType viewSize_;
+		::std::shared_ptr<const void> owner_;
+		Ordering order_;
+	};
+
+	// Deferred execution version of Vectorable.
+	// Filtering, Basic Operation and Conversion operators compose enumerators without touching any element;
+	// elements are pulled one by one only when a terminal operator (Count, Sum, First, to_vector, ...) runs.
+	// Operators which need the whole sequence (Reverse, OrderBy, Median, ...) materialize a Vectorable.
+	// The other terminal operators push the elements through the stages (Details::ForEach), so a chain like
+	// Where( p ).Select( f ).Sum() runs as one loop over the source with p, f and the sum inlined into it.
+	// Only those terminals are instrumented, as one Scope for the whole fused loop: its elements in are the ones which reach the terminal.
+	template<typename T, typename Enumerator>
+	class Enumerable
+	{
+	public:
+		using SizeType = ::std::size_t;
+		using EnumeratorType = Enumerator;
+
+	public:
+
+#pragma region Constructors
+
+		constexpr explicit Enumerable( Enumerator enumerator )
+			: enumerator_( ::std::move( enumerator ) )
+		{ }
+
+#pragma endregion
+
+#pragma region Getter
+
+		constexpr Enumerator GetEnumerator() const { return enumerator_; }
+
+		constexpr T First() const
+		{
+			auto enumerator = enumerator_;
+			if( !enumerator.MoveNext() )
+			{
+				OUTOFRANGEEX
+			}
+			return enumerator.Current();
+		}
+		constexpr T Last() const { return Last( ClosedForm() ); }
+		constexpr T At( SizeType index ) const { return At( index, ClosedForm() ); }
+
+		template<typename Predicate> constexpr T First( Predicate predicate ) const { return Where( predicate ).First(); }
+		template<typename Predicate> constexpr T Last( Predicate predicate ) const { return Where( predicate ).Last(); }
+
+		// Calls action( value ) for each element; an action which returns bool stops the enumeration by returning false.
+		template<typename Action>
+		constexpr void ForEach( Action action ) const
+		{
+			auto enumerator = enumerator_;
+			Details::ForEach( enumerator, action );
+		}
+
+#pragma endregion
+
+#pragma region Conditional Judgement
+
+		constexpr bool All( T element ) const
+		{
+			return All( ::std::bind( ::std::equal_to<T>(), ::std::placeholders::_1, element ) );
+		}
+		template<typename Predicate, typename = Details::InvokeResultT<Predicate, T>>
+		constexpr bool All( Predicate predicate ) const
+		{
+			return !Any( [&predicate]( const T& value ) { return !predicate( value ); } );
+		}
+
+		constexpr bool Any( T element ) const
+		{
+			return Any( ::std::bind( ::std::equal_to<T>(), ::std::placeholders::_1, element ) );
+		}
+		template<typename Predicate, typename = Details::InvokeResultT<Predicate, T>>
+		constexpr bool Any( Predicate predicate ) const
+		{
+			LINQINSTRUMENTIN( "Any", 0 )
+			bool ret = false;
+			auto test = [&predicate, &ret]( const T& value ) { ret = static_cast<bool>( predicate( value ) ); return !ret; };
+			ForEach( LINQCOUNTEDIN( test ) );
+			LINQINSTRUMENTOUT( 1, 0 )
+			return ret;
+		}
+
+		constexpr bool None( T element ) const { return !Any( element ); }
+		template<typename Predicate, typename = Details::InvokeResultT<Predicate, T>> constexpr bool None( Predicate predicate ) const { return !Any( predicate ); }
+
+		constexpr bool Empty() const
+		{
+			auto enumerator = enumerator_;
+			return !enumerator.MoveNext();
+		}
+
+		constexpr bool Contain( T element ) const { return Contain( element, ClosedForm() ); }
+		constexpr bool Include( T element ) const { return Contain( element ); }
+
+#pragma endregion
+
+#pragma region Basic Calc
+
+		constexpr SizeType Count() const { return Count( ClosedForm() ); }
+		constexpr SizeType Count( T element ) const
+		{
+			return Count( ::std::bind( ::std::equal_to<T>(), ::std::placeholders::_1, element ) );
+		}
+		template<typename Predicate, typename = Details::InvokeResultT<Predicate, T>>
+		constexpr SizeType Count( Predicate predicate ) const
+		{
+			LINQINSTRUMENTIN( "Count", 0 )
+			SizeType ret = 0;
+			auto count = [&predicate, &ret]( const T& value ) { ret += predicate( value ) ? 1 : 0; };
+			ForEach( LINQCOUNTEDIN( count ) );
+			LINQINSTRUMENTOUT( 1, 0 )
+			return ret;
+		}
+
+		// Floating point elements are added in double, like Vectorable::Sum.
+		constexpr T Sum() const
+		{
+			ARITHMETICABLECHECK
+
+			return Sum( ClosedForm() );
+		}
+
+		constexpr T Average() const
+		{
+			ARITHMETICABLECHECK
+
+			return Average( ClosedForm() );
+		}
+		template<typename S>
+		constexpr S Average() const
+		{
+			ARITHMETICABLECHECK
+
+			return Cast<S>().Average();
+		}
+		constexpr T Mean() const { return Average(); }
+		template<typename S> constexpr S Mean() const { return Average<S>(); }
+
+		constexpr T Minimum() const
+		{
+			ARITHMETICABLECHECK
+
+			return Minimum( ClosedForm() );
+		}
+
+		constexpr T Maximum() const
+		{
+			ARITHMETICABLECHECK
+
+			return Maximum( ClosedForm() );
+		}
+
+		constexpr T Median() const { return Median( ClosedForm() ); }
+		constexpr Statistics<T> Stats() const
+		{
+			ARITHMETICABLECHECK
+
+			// Buffered into blocks like Vectorable::Stats, so both give the same result and the SIMD kernels are used.
+			LINQINSTRUMENTIN( "Stats", 0 )
+			::std::vector<T> block;
+			block.reserve( Statistics<T>::BlockSize() );
+			Statistics<T> ret;
+			auto add = [&block, &ret]( T value )
+			{
+				block.push_back( value );
+				if( block.size() == Statistics<T>::BlockSize() )
+				{
+					ret.Merge( Statistics<T>( block.data(), block.size() ) );
+					block.clear();
+				}
+			};
+			ForEach( LINQCOUNTEDIN( add ) );
+			ret.Merge( Statistics<T>( block.data(), block.size() ) );
+			LINQINSTRUMENTOUT( 1, Details::CapacityBytes( block ) )
+			return ret;
+		}
+		template<typename S = T> constexpr S GeometricMean() const { return ToVectorable().template GeometricMean<S>(); }
+		template<typename S = T> constexpr S GeometricAverage() const { return GeometricMean<S>(); }
+		template<typename S = T> constexpr S HarmonicMean() const { return ToVectorable().template HarmonicMean<S>(); }
+		template<typename S = T> constexpr S HarmonicAverage() const { return HarmonicMean<S>(); }
+		constexpr T NthElement( SizeType n ) const { return ToVectorable().NthElement( n ); }
+		template<typename S = T> constexpr S Quantile( double q ) const { return ToVectorable().template Quantile<S>( q ); }
+		template<typename S = T> constexpr S Percentile( double p ) const { return ToVectorable().template Percentile<S>( p ); }
+		template<typename S = T> constexpr ::std::vector<S> Quantiles( const ::std::vector<double>& qs ) const { return ToVectorable().template Quantiles<S>( qs ); }
+		constexpr T Variance() const { return ToVectorable().Variance(); }
+		constexpr T StandardDeviation() const { return ToVectorable().StandardDeviation(); }
+
+		template<typename Func>
+		constexpr T Aggregate( T seed, Func func ) const
+		{
+			ARITHMETICABLECHECK
+
+			LINQINSTRUMENTIN( "Aggregate", 0 )
+			auto fold = [&seed, &func]( const T& value ) { seed = func( seed, value ); };
+			ForEach( LINQCOUNTEDIN( fold ) );
+			LINQINSTRUMENTOUT( 1, 0 )
+			return seed;
+		}
+
+		template<typename S = void, typename Func, typename ResultSelector, typename R = Details::SelectResultT<S, ResultSelector, T>>
+		constexpr R Aggregate( T seed, Func func, ResultSelector resultSelector ) const
+		{
+			ARITHMETICABLECHECK
+
+			return resultSelector( Aggregate( seed, func ) );
+		}
+
+#pragma endregion
+
+#pragma region Filtering
+
+		constexpr auto EqualTo( T value ) const
+		{
+			return Where( ::std::bind( ::std::equal_to<>(), ::std::placeholders::_1, value ) );
+		}
+
+		constexpr auto NotEqualTo( T value ) const
+		{
+			return Where( ::std::bind( ::std::not_equal_to<>(), ::std::placeholders::_1, value ) );
+		}
+
+		constexpr auto LessThan( T value ) const
+		{
+			ARITHMETICABLECHECK
+
+			return Where( ::std::bind( ::std::less<>(), ::std::placeholders::_1, value ) );
+		}
+
+		constexpr auto LessThanOrEqualTo( T value ) const
+		{
+			ARITHMETICABLECHECK
+
+			return Where( ::std::bind( ::std::less_equal<>(), ::std::placeholders::_1, value ) );
+		}
+
+		constexpr auto GreaterThan( T value ) const
+		{
+			ARITHMETICABLECHECK
+
+			return Where( ::std::bind( ::std::greater<>(), ::std::placeholders::_1, value ) );
+		}
+
+		constexpr auto GreaterThanOrEqualTo( T value ) const
+		{
+			ARITHMETICABLECHECK
+
+			return Where( ::std::bind( ::std::greater_equal<>(), ::std::placeholders::_1, value ) );
+		}
+
+		template<typename Predicate>
+		constexpr Enumerable<T, Details::WhereEnumerator<Enumerator, Predicate>> Where( Predicate predicate ) const
+		{
+			return Enumerable<T, Details::WhereEnumerator<Enumerator, Predicate>>(
+				Details::WhereEnumerator<Enumerator, Predicate>( enumerator_, ::std::move( predicate ) ) );
+		}
+
+#pragma endregion
+
+#pragma region Basic Operation
+
+		// Unlike Vectorable::Skip, skipping past the end yields an empty sequence because the size is unknown.
+		constexpr auto Skip( SizeType count ) const { return Skip( count, ClosedForm() ); }
+
+		template<typename Predicate>
+		constexpr Enumerable<T, Details::SkipWhileEnumerator<Enumerator, Predicate>> SkipWhile( Predicate predicate ) const
+		{
+			return Enumerable<T, Details::SkipWhileEnumerator<Enumerator, Predicate>>(
+				Details::SkipWhileEnumerator<Enumerator, Predicate>( enumerator_, ::std::move( predicate ) ) );
+		}
+
+		constexpr auto Take( SizeType count ) const { return Take( count, ClosedForm() ); }
+
+		template<typename Predicate>
+		constexpr Enumerable<T, Details::TakeWhileEnumerator<Enumerator, Predicate>> TakeWhile( Predicate predicate ) const
+		{
+			return Enumerable<T, Details::TakeWhileEnumerator<Enumerator, Predicate>>(
+				Details::TakeWhileEnumerator<Enumerator, Predicate>( enumerator_, ::std::move( predicate ) ) );
+		}
+
+		constexpr Vectorable<T> Reverse() const { return ToVectorable().Reverse(); }
+		constexpr Vectorable<T> Rotate( SizeType advance ) const { return ToVectorable().Rotate( advance ); }
+		constexpr Vectorable<T> OrderBy() const { return ToVectorable().OrderBy(); }
+		template<typename Predicate> constexpr auto OrderBy( Predicate predicate ) const { return ToVectorable().OrderBy( predicate ); }
+		constexpr Vectorable<T> OrderByDescending() const { return ToVectorable().OrderByDescending(); }
+		template<typename KeySelector> constexpr auto OrderByDescending( KeySelector keySelector ) const { return ToVectorable().OrderByDescending( keySelector ); }
+		constexpr auto Chunk( SizeType size ) const { return ToVectorable().Chunk( size ); }
+		constexpr auto Window( SizeType size, SizeType step = 1 ) const { return ToVectorable().Window( size, step ); }
+		constexpr Vectorable<T> MovingSum( SizeType size ) const { return ToVectorable().MovingSum( size ); }
+		template<typename S = T> constexpr Vectorable<S> MovingAverage( SizeType size ) const { return ToVectorable().template MovingAverage<S>( size ); }
+		constexpr Vectorable<T> MovingMinimum( SizeType size ) const { return ToVectorable().MovingMinimum( size ); }
+		constexpr Vectorable<T> MovingMaximum( SizeType size ) const { return ToVectorable().MovingMaximum( size ); }
+		template<typename S = T> constexpr Vectorable<S> MovingVariance( SizeType size ) const { return ToVectorable().template MovingVariance<S>( size ); }
+
+#pragma endregion
+
+#pragma region Set Calc
+
+		constexpr Vectorable<T> Distinct() const { return ToVectorable().Distinct(); }
+		template<typename Predicate> constexpr Vectorable<T> Distinct( Predicate predicate ) const { return ToVectorable().Distinct( predicate ); }
+		template<typename Hash, typename KeyEqual> constexpr Vectorable<T> Distinct( Hash hash, KeyEqual equal ) const { return ToVectorable().Distinct( hash, equal ); }
+
+#pragma endregion
+
+#pragma region Grouping
+
+		template<typename KeySelector, typename ElementSelector = Details::Identity>
+		constexpr auto GroupBy( KeySelector keySelector, ElementSelector elementSelector = ElementSelector() ) const
+		{
+			return ToVectorable().GroupBy( keySelector, elementSelector );
+		}
+
+#pragma endregion
+
+#pragma region Conversion
+
+		template<typename S>
+		constexpr auto Cast() const
+		{
+			return Select<S>( []( T value ) { return static_cast<S>( value ); } );
+		}
+
+		constexpr auto Square() const
+		{
+			ARITHMETICABLECHECK
+
+			return Select( Details::Power2<T> );
+		}
+
+		template<typename S = void, typename Selector, typename R = Details::SelectResultT<S, Selector, T>>
+		constexpr Enumerable<R, Details::SelectEnumerator<R, Enumerator, Selector>> Select( Selector selector ) const
+		{
+			return Enumerable<R, Details::SelectEnumerator<R, Enumerator, Selector>>(
+				Details::SelectEnumerator<R, Enumerator, Selector>( enumerator_, ::std::move( selector ) ) );
+		}
+
+#pragma endregion
+
+#pragma region Vectorlize/Maplize
+
+		constexpr Vectorable<T> ToVectorable() const
+		{
+			LINQINSTRUMENTIN( "ToVectorable", 0 )
+			::std::vector<typename Details::Wrap<T>::type> ret;
+			auto append = [&ret]( const T& value ) { ret.push_back( Details::MakeWrap( value ) ); };
+			ForEach( LINQCOUNTEDIN( append ) );
+			LINQINSTRUMENTOUT( ret.size(), Details::CapacityBytes( ret ) )
+			return Vectorable<T>( ::std::move( ret ) );
+		}
+
+#if defined( _VECTOR_ ) || defined( _LIBCPP_VECTOR ) || defined( _STLP_VECTOR ) || defined( _GLIBCXX_VECTOR )
+		constexpr ::std::vector<T> to_vector() const
+		{
+			LINQINSTRUMENTIN( "to_vector", 0 )
+			::std::vector<T> ret;
+			auto append = [&ret]( const T& value ) { ret.push_back( value ); };
+			ForEach( LINQCOUNTEDIN( append ) );
+			LINQINSTRUMENTOUT( ret.size(), Details::CapacityBytes( ret ) )
+			return ret;
+		}
+#endif
+
+#pragma endregion
+
+	private:
+		// The true_type overloads answer from the closed form of a Range or Repeat source, see Details::HasClosedForm.
+		// The tag is exactly true_type or false_type, so that it does not pick the predicate overloads of Last and Count.
+		using ClosedForm = ::std::integral_constant<bool, Details::HasClosedForm<Enumerator>::value>;
+
+		constexpr T Last( ::std::true_type ) const { return At( enumerator_.Count() - 1 ); }
+		constexpr T Last( ::std::false_type ) const
+		{
+			auto enumerator = enumerator_;
+			if( !enumerator.MoveNext() )
+			{
+				OUTOFRANGEEX
+			}
+
+			T ret = enumerator.Current();
+			while( enumerator.MoveNext() )
+			{
+				ret = enumerator.Current();
+			}
+			return ret;
+		}
+
+		constexpr T At( SizeType index, ::std::true_type ) const
+		{
+			if( index >= enumerator_.Count() )
+			{
+				OUTOFRANGEEX
+			}
+			return enumerator_.ElementAt( index );
+		}
+		constexpr T At( SizeType index, ::std::false_type ) const
+		{
+			auto enumerator = enumerator_;
+			for( SizeType i = 0; enumerator.MoveNext(); ++i )
+			{
+				if( i == index )
+				{
+					return enumerator.Current();
+				}
+			}
+
+			OUTOFRANGEEX
+		}
+
+		constexpr bool Contain( const T& element, ::std::true_type ) const { return enumerator_.Contain( element ); }
+		constexpr bool Contain( const T& element, ::std::false_type ) const { return Any( element ); }
+
+		constexpr SizeType Count( ::std::true_type ) const { return enumerator_.Count(); }
+		constexpr SizeType Count( ::std::false_type ) const
+		{
+			LINQINSTRUMENTIN( "Count", 0 )
+			SizeType ret = 0;
+			auto count = [&ret]( const T& ) { ++ret; };
+			ForEach( LINQCOUNTEDIN( count ) );
+			LINQINSTRUMENTOUT( 1, 0 )
+			return ret;
+		}
+
+		constexpr T Sum( ::std::true_type ) const { return enumerator_.Sum(); }
+		constexpr T Sum( ::std::false_type ) const
+		{
+			using Accumulator = ::std::conditional_t<::std::is_floating_point<T>::value, ::std::common_type_t<T, double>, T>;
+			LINQINSTRUMENTIN( "Sum", 0 )
+			Accumulator ret = static_cast<Accumulator>( 0 );
+			auto add = [&ret]( T value ) { ret += value; };
+			ForEach( LINQCOUNTEDIN( add ) );
+			LINQINSTRUMENTOUT( 1, 0 )
+			return static_cast<T>( ret );
+		}
+
+		constexpr T Average( ::std::true_type ) const { return enumerator_.Average(); }
+		constexpr T Average( ::std::false_type ) const
+		{
+			// Single pass: the pipeline is not re-executed for Count. Integers are added up in long double,
+			// so the sum does not overflow T before it is divided.
+			using Accumulator = ::std::conditional_t<::std::is_floating_point<T>::value, ::std::common_type_t<T, double>, long double>;
+			LINQINSTRUMENTIN( "Average", 0 )
+			Accumulator sum = static_cast<Accumulator>( 0 );
+			SizeType count = 0;
+			auto add = [&sum, &count]( T value ) { sum += value; ++count; };
+			ForEach( LINQCOUNTEDIN( add ) );
+			LINQINSTRUMENTOUT( 1, 0 )
+			return static_cast<T>( sum / static_cast<Accumulator>( count ) );
+		}
+
+		constexpr T Minimum( ::std::true_type ) const
+		{
+			if( enumerator_.Count() == 0 )
+			{
+				OUTOFRANGEEX
+			}
+			return enumerator_.ElementAt( 0 );
+		}
+		constexpr T Minimum( ::std::false_type ) const
+		{
+			LINQINSTRUMENTIN( "Minimum", 0 )
+			T ret = static_cast<T>( 0 );
+			bool empty = true;
+			auto compare = [&ret, &empty]( T value )
+			{
+				if( empty || value < ret )
+				{
+					ret = value;
+				}
+				empty = false;
+			};
+			ForEach( LINQCOUNTEDIN( compare ) );
+
+			if( empty )
+			{
+				OUTOFRANGEEX
+			}
+			LINQINSTRUMENTOUT( 1, 0 )
+			return ret;
+		}
+
+		constexpr T Maximum( ::std::true_type ) const
+		{
+			if( enumerator_.Count() == 0 )
+			{
+				OUTOFRANGEEX
+			}
+			return enumerator_.ElementAt( enumerator_.Count() - 1 );
+		}
+		constexpr T Maximum( ::std::false_type ) const
+		{
+			LINQINSTRUMENTIN( "Maximum", 0 )
+			T ret = static_cast<T>( 0 );
+			bool empty = true;
+			auto compare = [&ret, &empty]( T value )
+			{
+				if( empty || ret < value )
+				{
+					ret = value;
+				}
+				empty = false;
+			};
+			ForEach( LINQCOUNTEDIN( compare ) );
+
+			if( empty )
+			{
+				OUTOFRANGEEX
+			}
+			LINQINSTRUMENTOUT( 1, 0 )
+			return ret;
+		}
+
+		// The same middle elements as Vectorable::Median, which are at hand in an ascending sequence.
+		constexpr T Median( ::std::true_type ) const
+		{
+			const auto count = enumerator_.Count();
+			if( count == 0 )
+			{
+				OUTOFRANGEEX
+			}
+
+			const auto half = count / static_cast<SizeType>( 2 );
+			return count % 2 == 0 ? ( enumerator_.ElementAt( half - 1 ) + enumerator_.ElementAt( half ) ) / 2 : enumerator_.ElementAt( half );
+		}
+		constexpr T Median( ::std::false_type ) const { return ToVectorable().Median(); }
+
+		constexpr Enumerable Skip( SizeType count, ::std::true_type ) const { return Enumerable( enumerator_.Skip( count ) ); }
+		constexpr Enumerable<T, Details::SkipEnumerator<Enumerator>> Skip( SizeType count, ::std::false_type ) const
+		{
+			return Enumerable<T, Details::SkipEnumerator<Enumerator>>( Details::SkipEnumerator<Enumerator>( enumerator_, count ) );
+		}
+
+		constexpr Enumerable Take( SizeType count, ::std::true_type ) const { return Enumerable( enumerator_.Take( count ) ); }
+		constexpr Enumerable<T, Details::TakeEnumerator<Enumerator>> Take( SizeType count, ::std::false_type ) const
+		{
+			return Enumerable<T, Details::TakeEnumerator<Enumerator>>( Details::TakeEnumerator<Enumerator>( enumerator_, count ) );
+		}
+
+		Enumerator enumerator_;
+	};
+
+	// Parallel execution version of Vectorable, made by Vectorable::AsParallel.
+	// Operators split the sequence into chunks which run on Details::ThreadPool::Default().
+	// Sequences shorter than the sequential threshold, or a degree of parallelism of 1, run on the calling thread.
+	template<typename T>
+	class ParallelVectorable
+	{
+	public:
+		using SizeType = typename Vectorable<T>::SizeType;
+
+		static constexpr SizeType DefaultSequentialThreshold() { return 1 << 15; }
+		static inline SizeType DefaultDegreeOfParallelism() { return Details::ThreadPool::Default().ThreadCount() + 1; }
+
+	public:
+
+#pragma region Constructors
+
+		constexpr explicit ParallelVectorable( Vectorable<T> source )
+			: ParallelVectorable( ::std::move( source ), DefaultDegreeOfParallelism(), DefaultSequentialThreshold() )
+		{ }
+
+		constexpr ParallelVectorable( Vectorable<T> source, SizeType degreeOfParallelism, SizeType sequentialThreshold )
+			: source_( ::std::move( source ) )
+			, degreeOfParallelism_( ::std::max( degreeOfParallelism, static_cast<SizeType>( 1 ) ) )
+			, sequentialThreshold_( sequentialThreshold )
+		{ }
+
+#pragma endregion
+
+#pragma region Options
+
+		constexpr ParallelVectorable WithDegreeOfParallelism( SizeType degreeOfParallelism ) const
+		{
+			return ParallelVectorable( source_, degreeOfParallelism, sequentialThreshold_ );
+		}
+
+		constexpr ParallelVectorable WithSequentialThreshold( SizeType sequentialThreshold ) const
+		{
+			return ParallelVectorable( source_, degreeOfParallelism_, sequentialThreshold );
+		}
+
+		constexpr SizeType DegreeOfParallelism() const { return degreeOfParallelism_; }
+		constexpr SizeType SequentialThreshold() const { return sequentialThreshold_; }
+
+		constexpr Vectorable<T> AsSequential() const { return source_; }
+
+#pragma endregion
+
+#pragma region Basic Calc
+
+		constexpr SizeType Count() const { return source_.Count(); }
+		constexpr SizeType Count( T element ) const
+		{
+			return Count( ::std::bind( ::std::equal_to<T>(), ::std::placeholders::_1, element ) );
+		}
+		template<typename Predicate, typename = Details::InvokeResultT<Predicate, T>>
+		constexpr SizeType Count( Predicate predicate ) const
+		{
+			return Fold(
+				"Count",
+				static_cast<SizeType>( 0 ),
+				[&predicate]( SizeType count, T value ) { return predicate( value ) ? count + 1 : count; },
+				::std::plus<SizeType>() );
+		}
+
+		constexpr T Sum() const
+		{
+			ARITHMETICABLECHECK
+
+			const auto first = source_.CBegin();
+			return Reduce(
+				"Sum",
+				static_cast<T>( 0 ),
+				[first]( SizeType begin, SizeType end ) { return Details::Simd::Sum( first + begin, end - begin ); },
+				::std::plus<T>() );
+		}
+
+		constexpr T Average() const
+		{
+			ARITHMETICABLECHECK
+
+			return Sum() / static_cast<T>( Count() );
+		}
+		constexpr T Mean() const { return Average(); }
+
+		constexpr Statistics<T> Stats() const
+		{
+			ARITHMETICABLECHECK
+
+			const auto first = source_.CBegin();
+			return Reduce(
+				"Stats",
+				Statistics<T>(),
+				[first]( SizeType begin, SizeType end ) { return Statistics<T>( first + begin, end - begin ); },
+				[]( Statistics<T> lhs, const Statistics<T>& rhs ) { lhs.Merge( rhs ); return lhs; } );
+		}
+
+		// Each chunk folds its elements into a copy of seed with func, then the chunk results are merged with combiner
+		// as a balanced binary tree. So seed must be an identity of combiner, e.g. 0 for plus.
+		template<typename S, typename Func, typename Combiner>
+		constexpr S Aggregate( S seed, Func func, Combiner combiner ) const
+		{
+			return Fold( "Aggregate", seed, func, combiner );
+		}
+		template<typename Func>
+		constexpr T Aggregate( T seed, Func func ) const
+		{
+			ARITHMETICABLECHECK
+
+			return Aggregate( seed, func, func );
+		}
+
+#pragma endregion
+
+#pragma region Filtering
+
+		// Each chunk filters into its own buffer; the buffers are concatenated in chunk order, so the order is preserved.
+		template<typename Predicate>
+		constexpr ParallelVectorable Where( Predicate predicate ) const
+		{
+			const auto first = source_.CBegin();
+			const auto chunkCount = ChunkCount();
+			if( chunkCount <= 1 )
+			{
+				return WithSource( source_.Where( predicate ) );
+			}
+
+			LINQINSTRUMENT( "Where" )
+			::std::vector<::std::vector<typename Details::Wrap<T>::type>> parts( chunkCount );
+			Run( chunkCount, [&]( SizeType begin, SizeType end, SizeType chunk )
+			{
+				auto& part = parts[chunk];
+				for( auto i = begin; i < end; ++i )
+				{
+					if( predicate( Details::Unwrap( first[i] ) ) )
+					{
+						part.push_back( first[i] );
+					}
+				}
+			} );
+
+			::std::vector<SizeType> offsets( chunkCount + 1, 0 );
+			for( SizeType i = 0; i < chunkCount; ++i )
+			{
+				offsets[i + 1] = offsets[i] + parts[i].size();
+			}
+
+			::std::vector<typename Details::Wrap<T>::type> ret( offsets[chunkCount] );
+			Run( chunkCount, [&]( SizeType, SizeType, SizeType chunk )
+			{
+				::std::copy( ::std::cbegin( parts[chunk] ), ::std::cend( parts[chunk] ), ::std::begin( ret ) + offsets[chunk] );
+			} );
+			LINQINSTRUMENTOUT( ret.size(), Details::CapacityBytes( ret ) )
+			return WithSource( Vectorable<T>( ::std::move( ret ) ) );
+		}
+
+#pragma endregion
+
+#pragma region Conversion
+
+		template<typename S = void, typename Selector, typename R = Details::SelectResultT<S, Selector, T>>
+		constexpr ParallelVectorable<R> Select( Selector selector ) const
+		{
+			const auto first = source_.CBegin();
+			const auto chunkCount = ChunkCount();
+			if( chunkCount <= 1 )
+			{
+				return ParallelVectorable<R>( source_.template Select<R>( selector ), degreeOfParallelism_, sequentialThreshold_ );
+			}
+
+			LINQINSTRUMENT( "Select" )
+			Vectorable<R> ret( source_.Count() );
+			const auto out = ret.Begin();
+			Run( chunkCount, [&]( SizeType begin, SizeType end, SizeType )
+			{
+				for( auto i = begin; i < end; ++i )
+				{
+					out[i] = Details::MakeWrap( static_cast<R>( selector( Details::Unwrap( first[i] ) ) ) );
+				}
+			} );
+			LINQINSTRUMENTOUT( ret.Count(), ret.Count() * sizeof( typename Details::Wrap<R>::type ) )
+			return ParallelVectorable<R>( ::std::move( ret ), degreeOfParallelism_, sequentialThreshold_ );
+		}
+
+#pragma endregion
+
+#pragma region Vectorlize/Maplize
+
+#if defined( _VECTOR_ ) || defined( _LIBCPP_VECTOR ) || defined( _STLP_VECTOR ) || defined( _GLIBCXX_VECTOR )
+		constexpr ::std::vector<T> to_vector() const { return source_.to_vector(); }
+#endif
+
+#pragma endregion
+
+	private:
+		// Several chunks per thread, so that threads which finish early pick up the rest.
+		constexpr SizeType ChunkCount() const
+		{
+			const auto count = source_.Count();
+			if( degreeOfParallelism_ <= 1 || count < ::std::max( sequentialThreshold_, static_cast<SizeType>( 2 ) ) )
+			{
+				return 1;
+			}
+			return ::std::min( count, degreeOfParallelism_ * 4 );
+		}
+
+		template<typename S, typename Func, typename Combiner>
+		constexpr S Fold( const char* name, S seed, Func func, Combiner combiner ) const
+		{
+			const auto first = source_.CBegin();
+			return Reduce(
+				name,
+				seed,
+				[first, seed, &func]( SizeType begin, SizeType end )
+				{
+					auto value = seed;
+					for( auto i = begin; i < end; ++i )
+					{
+						value = func( value, Details::Unwrap( first[i] ) );
+					}
+					return value;
+				},
+				combiner );
+		}
+
+		// chunkReducer( begin, end ) reduces one chunk; the chunk results are merged with combiner as a balanced binary tree.
+		// The whole reduction is one Scope of name, which does not count the calls made on the worker threads.
+		template<typename S, typename ChunkReducer, typename Combiner>
+		constexpr S Reduce( const char* name, S seed, ChunkReducer chunkReducer, Combiner combiner ) const
+		{
+			LINQINSTRUMENT( name )
+			LINQINSTRUMENTOUT( 1, 0 )
+			const auto chunkCount = ChunkCount();
+			if( chunkCount <= 1 )
+			{
+				return chunkReducer( 0, source_.Count() );
+			}
+
+			::std::vector<S> partials( chunkCount, seed );
+			Run( chunkCount, [&]( SizeType begin, SizeType end, SizeType chunk ) { partials[chunk] = chunkReducer( begin, end ); } );
+
+			for( SizeType step = 1; step < chunkCount; step *= 2 )
+			{
+				for( SizeType i = 0; i + step < chunkCount; i += step * 2 )
+				{
+					partials[i] = combiner( partials[i], partials[i + step] );
+				}
+			}
+			return partials[0];
+		}
+
+		template<typename Body>
+		constexpr void Run( SizeType chunkCount, Body body ) const
+		{
+			Details::ParallelFor( Details::ThreadPool::Default(), source_.Count(), chunkCount, ::std::min( degreeOfParallelism_, chunkCount ), body );
+		}
+
+		constexpr ParallelVectorable WithSource( Vectorable<T> source ) const
+		{
+			return ParallelVectorable( ::std::move( source ), degreeOfParallelism_, sequentialThreshold_ );
+		}
+
+		Vectorable<T> source_;
+		SizeType degreeOfParallelism_;
+		SizeType sequentialThreshold_;
+	};
+
+#pragma region Grouping
+
+	// The groups of a GroupBy. Each group is stored contiguously in the source order, and the groups are in the order of
+	// the first occurrence of their keys. The Vectorables returned by At and operator[] borrow the storage of the Lookup,
+	// so they must not outlive it.
+	template<typename Key, typename Element, typename Hash, typename KeyEqual>
+	class Lookup
+	{
+	public:
+		using SizeType = ::std::size_t;
+
+	public:
+		Lookup( Details::FlatHashSet<Key, Hash, KeyEqual>&& keys, ::std::vector<SizeType>&& offsets, ::std::vector<typename Details::Wrap<Element>::type>&& elements )
+			: keys_( ::std::move( keys ) )
+			, offsets_( ::std::move( offsets ) )
+			, elements_( ::std::move( elements ) )
+		{ }
+
+		// The number of groups.
+		constexpr SizeType Count() const { return keys_.Count(); }
+
+		constexpr const Key& KeyAt( SizeType index ) const
+		{
+			if( index >= Count() )
+			{
+				OUTOFRANGEEX
+			}
+			return keys_[index];
+		}
+
+		constexpr Vectorable<Element> At( SizeType index ) const
+		{
+			if( index >= Count() )
+			{
+				OUTOFRANGEEX
+			}
+			return Vectorable<Element>( elements_.data() + offsets_[index], offsets_[index + 1] - offsets_[index], Details::BorrowTag() );
+		}
+
+		// Like .NET ILookup, a missing key gives an empty group.
+		constexpr Vectorable<Element> operator[]( const Key& key ) const
+		{
+			const auto index = keys_.Find( key );
+			return index != keys_.npos ? At( index ) : Vectorable<Element>( 0 );
+		}
+
+		constexpr bool Contain( const Key& key ) const { return keys_.Find( key ) != keys_.npos; }
+		constexpr bool Include( const Key& key ) const { return Contain( key ); }
+
+		// selector( key, group ) for each group.
+		template<typename S = void, typename Selector, typename R = Details::SelectResultT<S, Selector, const Key&, Vectorable<Element>>>
+		constexpr Vectorable<R> Select( Selector selector ) const
+		{
+			::std::vector<typename Details::Wrap<R>::type> ret;
+			ret.reserve( Count() );
+			for( SizeType i = 0; i < Count(); ++i )
+			{
+				ret.push_back( Details::MakeWrap( static_cast<R>( selector( keys_[i], At( i ) ) ) ) );
+			}
+			return Vectorable<R>( ::std::move( ret ) );
+		}
+
+	private:
+		Details::FlatHashSet<Key, Hash, KeyEqual> keys_;
+		::std::vector<SizeType> offsets_;
+		::std::vector<typename Details::Wrap<Element>::type> elements_;
+	};
+
+	// The deferred result of Vectorable::GroupBy. Nothing is grouped until ToLookup or Aggregate is called.
+	template<typename T, typename KeySelector, typename ElementSelector, typename Hash, typename KeyEqual>
+	class GroupedVectorable
+	{
+	public:
+		using SizeType = typename Vectorable<T>::SizeType;
+		using KeyType = ::std::decay_t<Details::InvokeResultT<KeySelector, T>>;
+		using ElementType = ::std::decay_t<Details::InvokeResultT<ElementSelector, T>>;
+
+	public:
+		constexpr GroupedVectorable( Vectorable<T> source, KeySelector keySelector, ElementSelector elementSelector, Hash hash, KeyEqual equal )
+			: source_( ::std::move( source ) )
+			, keySelector_( keySelector )
+			, elementSelector_( elementSelector )
+			, hash_( hash )
+			, equal_( equal )
+		{ }
+
+		// Two passes: the first one assigns a group id to each element and counts the groups,
+		// the second one scatters the elements to their group's range.
+		constexpr Lookup<KeyType, ElementType, Hash, KeyEqual> ToLookup() const
+		{
+			const auto first = source_.CBegin();
+			const auto count = source_.Count();
+
+			Details::FlatHashSet<KeyType, Hash, KeyEqual> keys( hash_, equal_ );
+			::std::vector<SizeType> ids( count );
+			::std::vector<SizeType> offsets;
+			for( SizeType i = 0; i < count; ++i )
+			{
+				const auto id = keys.Insert( keySelector_( Details::Unwrap( first[i] ) ) ).first;
+				if( id == offsets.size() )
+				{
+					offsets.push_back( 0 );
+				}
+				++offsets[id];
+				ids[i] = id;
+			}
+
+			SizeType sum = 0;
+			for( auto& offset : offsets )
+			{
+				const auto groupCount = offset;
+				offset = sum;
+				sum += groupCount;
+			}
+			offsets.push_back( sum );
+
+			::std::vector<SizeType> order( count );
+			auto cursors = offsets;
+			for( SizeType i = 0; i < count; ++i )
+			{
+				order[cursors[ids[i]]++] = i;
+			}
+
+			::std::vector<typename Details::Wrap<ElementType>::type> elements;
+			elements.reserve( count );
+			for( const auto i : order )
+			{
+				elements.push_back( Details::MakeWrap( elementSelector_( Details::Unwrap( first[i] ) ) ) );
+			}
+			return Lookup<KeyType, ElementType, Hash, KeyEqual>( ::std::move( keys ), ::std::move( offsets ), ::std::move( elements ) );
+		}
+
+		// Folds the elements of each group into a copy of seed in one pass, without storing the groups.
+		// The result has a ( key, value ) pair per group, in the order of the first occurrence of the keys.
+		template<typename S, typename Func>
+		constexpr Vectorable<::std::pair<KeyType, S>> Aggregate( S seed, Func func ) const
+		{
+			Details::FlatHashSet<KeyType, Hash, KeyEqual> keys( hash_, equal_ );
+			::std::vector<S> values;
+			for( auto itr = source_.CBegin(); itr != source_.CEnd(); ++itr )
+			{
+				const auto& value = Details::Unwrap( *itr );
+				const auto id = keys.Insert( keySelector_( value ) ).first;
+				if( id == values.size() )
+				{
+					values.push_back( seed );
+				}
+				values[id] = func( values[id], elementSelector_( value ) );
+			}
+
+			::std::vector<::std::pair<KeyType, S>> ret;
+			ret.reserve( values.size() );
+			for( SizeType id = 0; id < values.size(); ++id )
+			{
+				ret.emplace_back( keys[id], ::std::move( values[id] ) );
+			}
+			return Vectorable<::std::pair<KeyType, S>>( ::std::move( ret ) );
+		}
+
+		// The number of elements in each group.
+		constexpr Vectorable<::std::pair<KeyType, SizeType>> Count() const
+		{
+			return Aggregate( static_cast<SizeType>( 0 ), []( SizeType count, const ElementType& ) { return count + 1; } );
+		}
+
+	private:
+		Vectorable<T> source_;
+		KeySelector keySelector_;
+		ElementSelector elementSelector_;
+		Hash hash_;
+		KeyEqual equal_;
+	};
+
+	// The deferred result of Vectorable::OrderBy( keySelector ) and OrderByDescending( keySelector ), with one Details::SortLevel
+	// per key. ThenBy and ThenByDescending add a level; ToVectorable sorts.
+	template<typename T, typename Allocator, typename... Levels>
+	class OrderedVectorable
+	{
+	public:
+		using SizeType = typename Vectorable<T, Allocator>::SizeType;
+
+	public:
+		constexpr OrderedVectorable( Vectorable<T, Allocator> source, ::std::tuple<Levels...> levels )
+			: source_( ::std::move( source ) )
+			, levels_( ::std::move( levels ) )
+		{ }
+
+		template<typename KeySelector>
+		constexpr OrderedVectorable<T, Allocator, Levels..., Details::SortLevel<KeySelector, false>> ThenBy( KeySelector keySelector ) const &
+		{
+			return Then<false>( source_, keySelector );
+		}
+		template<typename KeySelector>
+		constexpr OrderedVectorable<T, Allocator, Levels..., Details::SortLevel<KeySelector, false>> ThenBy( KeySelector keySelector ) &&
+		{
+			return Then<false>( ::std::move( source_ ), keySelector );
+		}
+
+		template<typename KeySelector>
+		constexpr OrderedVectorable<T, Allocator, Levels..., Details::SortLevel<KeySelector, true>> ThenByDescending( KeySelector keySelector ) const &
+		{
+			return Then<true>( source_, keySelector );
+		}
+		template<typename KeySelector>
+		constexpr OrderedVectorable<T, Allocator, Levels..., Details::SortLevel<KeySelector, true>> ThenByDescending( KeySelector keySelector ) &&
+		{
+			return Then<true>( ::std::move( source_ ), keySelector );
+		}
+
+		// Decorate, sort, undecorate: the keys of each element are computed once into a ( keys, index ) array, which is sorted
+		// instead of the elements, and the elements are then gathered in that order (moved when the source owns them).
+		constexpr Vectorable<T, Allocator> ToVectorable() const &
+		{
+			return Gather( source_.CBegin() );
+		}
+		constexpr Vectorable<T, Allocator> ToVectorable() &&
+		{
+			return source_.IsBorrowed() ? Gather( source_.CBegin() ) : Gather( ::std::make_move_iterator( source_.Begin() ) );
+		}
+
+		constexpr ::std::vector<T> to_vector() const { return ToVectorable().to_vector(); }
+
+	private:
+		using Keys = Details::SortKeys<T, Levels...>;
+		using Decorated = ::std::pair<Keys, SizeType>;
+
+		template<bool Descending, typename Source, typename KeySelector>
+		constexpr OrderedVectorable<T, Allocator, Levels..., Details::SortLevel<KeySelector, Descending>> Then( Source&& source, KeySelector keySelector ) const
+		{
+			return OrderedVectorable<T, Allocator, Levels..., Details::SortLevel<KeySelector, Descending>>(
+				::std::forward<Source>( source ),
+				::std::tuple_cat( levels_, ::std::make_tuple( Details::SortLevel<KeySelector, Descending> { keySelector } ) ) );
+		}
+
+		template<::std::size_t... I>
+		constexpr Keys MakeKeys( const T& value, ::std::index_sequence<I...> ) const
+		{
+			return Keys( value, ::std::get<I>( levels_ )... );
+		}
+
+		template<typename Itr>
+		constexpr Vectorable<T, Allocator> Gather( Itr first ) const
+		{
+			const auto count = source_.Count();
+			LINQINSTRUMENTIN( "OrderBy", count )
+			::std::vector<Decorated> decorated;
+			decorated.reserve( count );
+			for( SizeType i = 0; i < count; ++i )
+			{
+				decorated.emplace_back( MakeKeys( Details::Unwrap( source_.CBegin()[i] ), ::std::index_sequence_for<Levels...>() ), i );
+			}
+			Details::SortDecorated( decorated.data(), decorated.data() + count, Details::IsRadixSortable<T, Levels...>() );
+
+			typename Vectorable<T, Allocator>::StorageType ret( source_.GetAllocator() );
+			ret.reserve( count );
+			for( const auto& element : decorated )
+			{
+				ret.push_back( first[element.second] );
+			}
+			LINQINSTRUMENTOUT( count, Details::CapacityBytes( ret ) + count * sizeof( Decorated ) )
+			return Vectorable<T, Allocator>( ::std::move( ret ) );
+		}
+
+	private:
+		Vectorable<T, Allocator> source_;
+		::std::tuple<Levels...> levels_;
+	};
+
+#pragma endregion
+
+#pragma region Observable
+
+	template<typename T> class Observable;
+	template<typename R> class Observed;
+
+	namespace Details {
+
+		// A stage of an Observable: OnNext gets each value pushed through, and OnExpire each value which a Window upstream lets go.
+		// index numbers the values of the Subject in the order they came, and OnExpire gets the one OnNext got for the value.
+		// The expiries come in the order of the values, except after a Distinct, which expires a value when its last occurrence goes.
+		template<typename T>
+		class Observer
+		{
+		public:
+			virtual ~Observer() = default;
+			virtual void OnNext( const T& value, ::std::size_t index ) = 0;
+			virtual void OnExpire( const T& value, ::std::size_t index ) = 0;
+		};
+
+		// The stages subscribed to one Observable, which get what it lets through.
+		template<typename T>
+		class Subject
+		{
+		public:
+			Subject()
+				: count_( 0 )
+			{ }
+
+			void Subscribe( ::std::shared_ptr<Observer<T>> observer ) { observers_.push_back( ::std::move( observer ) ); }
+
+			// Returns the index of value.
+			::std::size_t Next( const T& value )
+			{
+				const auto index = count_++;
+				for( const auto& observer : observers_ )
+				{
+					observer->OnNext( value, index );
+				}
+				return index;
+			}
+
+			void Expire( const T& value, ::std::size_t index ) const
+			{
+				for( const auto& observer : observers_ )
+				{
+					observer->OnExpire( value, index );
+				}
+			}
+
+		private:
+			::std::vector<::std::shared_ptr<Observer<T>>> observers_;
+			::std::size_t count_;
+		};
+
+		// Calls predicate once per value. Behind a Window, the index each admitted value got downstream is kept until it expires,
+		// so an expiry takes out exactly what was let through, without calling predicate again.
+		template<typename T, typename Predicate>
+		class WhereObserver
+			: public Observer<T>
+		{
+		public:
+			WhereObserver( ::std::shared_ptr<Subject<T>> subject, Predicate predicate, bool windowed )
+				: subject_( ::std::move( subject ) )
+				, predicate_( predicate )
+				, windowed_( windowed )
+			{ }
+
+			void OnNext( const T& value, ::std::size_t index ) override
+			{
+				if( !predicate_( value ) )
+				{
+					return;
+				}
+				const auto admitted = subject_->Next( value );
+				if( windowed_ )
+				{
+					admitted_.emplace( index, admitted );
+				}
+			}
+
+			void OnExpire( const T& value, ::std::size_t index ) override
+			{
+				const auto admitted = admitted_.find( index );
+				if( admitted == admitted_.end() )
+				{
+					return;
+				}
+				const auto expired = admitted->second;
+				admitted_.erase( admitted );
+				subject_->Expire( value, expired );
+			}
+
+		private:
+			::std::shared_ptr<Subject<T>> subject_;
+			Predicate predicate_;
+			bool windowed_;
+			::std::unordered_map<::std::size_t, ::std::size_t> admitted_;
+		};
+
+		// Calls selector once per value. Behind a Window, each projected value is kept until it expires.
+		template<typename T, typename R, typename Selector>
+		class SelectObserver
+			: public Observer<T>
+		{
+		public:
+			SelectObserver( ::std::shared_ptr<Subject<R>> subject, Selector selector, bool windowed )
+				: subject_( ::std::move( subject ) )
+				, selector_( selector )
+				, windowed_( windowed )
+			{ }
+
+			void OnNext( const T& value, ::std::size_t index ) override
+			{
+				auto projected = static_cast<R>( selector_( value ) );
+				const auto projectedIndex = subject_->Next( projected );
+				if( windowed_ )
+				{
+					projected_.emplace( index, ::std::make_pair( ::std::move( projected ), projectedIndex ) );
+				}
+			}
+
+			void OnExpire( const T&, ::std::size_t index ) override
+			{
+				const auto projected = projected_.find( index );
+				if( projected == projected_.end() )
+				{
+					return;
+				}
+				const auto expired = ::std::move( projected->second );
+				projected_.erase( projected );
+				subject_->Expire( expired.first, expired.second );
+			}
+
+		private:
+			::std::shared_ptr<Subject<R>> subject_;
+			Selector selector_;
+			bool windowed_;
+			::std::unordered_map<::std::size_t, ::std::pair<R, ::std::size_t>> projected_;
+		};
+
+		// Lets a value through when it has no other occurrence in the window, and expires it when its last occurrence goes.
+		// The key of the last occurrence is erased with it, so behind a Window only the keys in the window are kept.
+		template<typename T, typename Hash, typename KeyEqual>
+		class DistinctObserver
+			: public Observer<T>
+		{
+		public:
+			DistinctObserver( ::std::shared_ptr<Subject<T>> subject, Hash hash, KeyEqual equal )
+				: subject_( ::std::move( subject ) )
+				, counts_( 0, hash, equal )
+			{ }
+
+			void OnNext( const T& value, ::std::size_t ) override
 			{
-				const auto data = data_[i];
-				if( !predicate( data ) )
+				auto& count = counts_[value];
+				if( count.first++ == 0 )
 				{
-					break;
+					count.second = subject_->Next( value );
 				}
+			}
 
-				ret.data_[i] = data;
+			void OnExpire( const T& value, ::std::size_t ) override
+			{
+				const auto count = counts_.find( value );
+				if( count == counts_.end() || --count->second.first != 0 )
+				{
+					return;
+				}
+				const auto expired = count->second.second;
+				counts_.erase( count );
+				subject_->Expire( value, expired );
 			}
 
-			ret.data_.resize( i );
-			return ::std::move( ret );
-		}
+		private:
+			::std::shared_ptr<Subject<T>> subject_;
+			// The number of occurrences of each key, and the index the first of them got downstream.
+			::std::unordered_map<T, ::std::pair<::std::size_t, ::std::size_t>, Hash, KeyEqual> counts_;
+		};
+
+		// Keeps the last size values, and expires the oldest one when a new one comes in.
+		template<typename T>
+		class WindowObserver
+			: public Observer<T>
+		{
+		public:
+			WindowObserver( ::std::shared_ptr<Subject<T>> subject, ::std::size_t size )
+				: subject_( ::std::move( subject ) )
+				, size_( size )
+				, expiredAhead_( 0 )
+				, front_( 0 )
+			{ }
+
+			void OnNext( const T& value, ::std::size_t ) override
+			{
+				values_.push_back( value );
+				subject_->Next( value );
+				if( values_.size() > size_ )
+				{
+					++expiredAhead_;
+					ExpireFront();
+				}
+			}
+
+			// A window upstream expires its oldest value, which this one has either expired already or still has at its front.
+			void OnExpire( const T&, ::std::size_t ) override
+			{
+				if( expiredAhead_ != 0 )
+				{
+					--expiredAhead_;
+					return;
+				}
+				ExpireFront();
+			}
+
+		private:
+			void ExpireFront()
+			{
+				const auto oldest = ::std::move( values_.front() );
+				values_.pop_front();
+				subject_->Expire( oldest, front_++ );
+			}
+
+			::std::shared_ptr<Subject<T>> subject_;
+			::std::size_t size_;
+			::std::deque<T> values_;
+			::std::size_t expiredAhead_;
+			// The index of the front of values_.
+			::std::size_t front_;
+		};
+
+		// The current result of an aggregate subscribed to an Observable, read by Observed<R>.
+		template<typename R>
+		class Aggregator
+		{
+		public:
+			virtual ~Aggregator() = default;
+			virtual R Value() const = 0;
+			virtual ::std::size_t Count() const = 0;
+		};
+
+		template<typename T>
+		class CountAggregator
+			: public Observer<T>
+			, public Aggregator<::std::size_t>
+		{
+		public:
+			void OnNext( const T&, ::std::size_t ) override { ++count_; }
+			void OnExpire( const T&, ::std::size_t ) override { --count_; }
+
+			::std::size_t Value() const override { return count_; }
+			::std::size_t Count() const override { return count_; }
+
+		private:
+			::std::size_t count_ = 0;
+		};
+
+		// The running sum, which an expiry subtracts from. Like Vectorable::Average, the average is computed in T.
+		// A floating point sum is compensated (Neumaier), so that the rounding errors of a long stream of additions and
+		// subtractions do not add up, and a small value is not lost in the sum while a large one is in the window.
+		template<typename T, bool Average>
+		class SumAggregator
+			: public Observer<T>
+			, public Aggregator<T>
+		{
+		public:
+			void OnNext( const T& value, ::std::size_t ) override
+			{
+				Add( value, ::std::is_floating_point<T>() );
+				++count_;
+			}
+
+			void OnExpire( const T& value, ::std::size_t ) override
+			{
+				Remove( value, ::std::is_floating_point<T>() );
+				--count_;
+			}
+
+			T Value() const override
+			{
+				const auto sum = sum_ + compensation_;
+				if( !Average )
+				{
+					return sum;
+				}
+				if( count_ == 0 )
+				{
+					OUTOFRANGEEX
+				}
+				return sum / static_cast<T>( count_ );
+			}
+
+			::std::size_t Count() const override { return count_; }
+
+		private:
+			void Add( const T& value, ::std::false_type )
+			{
+				sum_ += value;
+			}
+			void Add( const T& value, ::std::true_type )
+			{
+				const auto sum = sum_ + value;
+				if( ::std::abs( sum_ ) >= ::std::abs( value ) )
+				{
+					compensation_ += ( sum_ - sum ) + value;
+				}
+				else
+				{
+					compensation_ += ( value - sum ) + sum_;
+				}
+				sum_ = sum;
+			}
+
+			void Remove( const T& value, ::std::false_type )
+			{
+				sum_ -= value;
+			}
+			void Remove( const T& value, ::std::true_type )
+			{
+				Add( -value, ::std::true_type() );
+			}
+
+			T sum_ = T();
+			// The low order part which sum_ lost, always 0 unless T is a floating point type.
+			T compensation_ = T();
+			::std::size_t count_ = 0;
+		};
+
+		// comp( x, y ) when x wins over y. Behind a Window, the candidates are a monotonic deque: a value removes the ones
+		// it wins over from the back, and an expiry removes the front when it is that value, so each value is pushed
+		// and popped once. Without a Window only the winner is kept. The deque needs the expiries in the order of the values;
+		// after a windowed Distinct, which expires out of order, the values are counted in a map in comp order instead.
+		template<typename T, typename Compare>
+		class ExtremeAggregator
+			: public Observer<T>
+			, public Aggregator<T>
+		{
+		public:
+			ExtremeAggregator( bool windowed, bool ordered )
+				: windowed_( windowed )
+				, ordered_( ordered )
+				, count_( 0 )
+			{ }
+
+			void OnNext( const T& value, ::std::size_t ) override
+			{
+				++count_;
+				if( !ordered_ )
+				{
+					++counts_[value];
+					return;
+				}
+				if( !windowed_ )
+				{
+					if( candidates_.empty() )
+					{
+						candidates_.push_back( value );
+					}
+					else if( comp_( value, candidates_.front() ) )
+					{
+						candidates_.front() = value;
+					}
+					return;
+				}
+
+				while( !candidates_.empty() && comp_( value, candidates_.back() ) )
+				{
+					candidates_.pop_back();
+				}
+				candidates_.push_back( value );
+			}
+
+			void OnExpire( const T& value, ::std::size_t ) override
+			{
+				--count_;
+				if( !ordered_ )
+				{
+					const auto count = counts_.find( value );
+					if( count != counts_.end() && --count->second == 0 )
+					{
+						counts_.erase( count );
+					}
+					return;
+				}
+				if( !candidates_.empty() && !comp_( candidates_.front(), value ) && !comp_( value, candidates_.front() ) )
+				{
+					candidates_.pop_front();
+				}
+			}
+
+			T Value() const override
+			{
+				if( !ordered_ )
+				{
+					if( counts_.empty() )
+					{
+						OUTOFRANGEEX
+					}
+					return counts_.begin()->first;
+				}
+				if( candidates_.empty() )
+				{
+					OUTOFRANGEEX
+				}
+				return candidates_.front();
+			}
+
+			::std::size_t Count() const override { return count_; }
+
+		private:
+			Compare comp_;
+			bool windowed_;
+			bool ordered_;
+			::std::size_t count_;
+			::std::deque<T> candidates_;
+			::std::map<T, ::std::size_t, Compare> counts_;
+		};
+
+	}
+
+	// The live result of an aggregate of an Observable, updated as the values are pushed.
+	template<typename R>
+	class Observed
+	{
+	public:
+		using SizeType = ::std::size_t;
+
+	public:
+		explicit Observed( ::std::shared_ptr<const Details::Aggregator<R>> aggregator )
+			: aggregator_( ::std::move( aggregator ) )
+		{ }
+
+		R Value() const { return aggregator_->Value(); }
+
+		// The number of values in the aggregate: all the values so far, or the ones in the Window.
+		SizeType Count() const { return aggregator_->Count(); }
+		bool Empty() const { return Count() == 0; }
 
-		constexpr Vectorable Reverse() const
+	private:
+		::std::shared_ptr<const Details::Aggregator<R>> aggregator_;
+	};
+
+	// A push-based source. OnNext( value ) sends value through the stages subscribed to it (Where, Select, Distinct, Window),
+	// and the aggregates at their ends (Count, Sum, Average, Minimum, Maximum) keep their results up to date in O( 1 ) amortized
+	// per value, instead of running a query over a buffer again for every value. After Window( size ) they cover the last
+	// size values: sums and counts subtract the values which leave it, and Minimum / Maximum keep a monotonic deque.
+	// The stages live as long as the source; the values are pushed from one thread at a time.
+	template<typename T>
+	class Observable
+	{
+		template<typename U> friend class Observable;
+
+	public:
+		using SizeType = ::std::size_t;
+
+	public:
+		Observable()
+			: Observable( ::std::make_shared<Details::Subject<T>>(), false, true )
+		{ }
+
+		void OnNext( const T& value ) const { subject_->Next( value ); }
+
+#pragma region Filtering
+
+		// predicate and selector are called once per value: behind a Window, what they gave is kept and taken out on expiry,
+		// so they may have state, and an expensive selector is not run again.
+		template<typename Predicate>
+		Observable Where( Predicate predicate ) const
 		{
-			Vectorable ret( data_.size() );
-			::std::reverse_copy( ::std::cbegin( data_ ), ::std::cend( data_ ), ::std::begin( ret.data_ ) );
-			return ::std::move( ret );
+			Observable ret( ::std::make_shared<Details::Subject<T>>(), windowed_, ordered_ );
+			subject_->Subscribe( ::std::make_shared<Details::WhereObserver<T, Predicate>>( ret.subject_, predicate, windowed_ ) );
+			return ret;
 		}
 
-		constexpr Vectorable Rotate( SizeType advance ) const
+		template<typename S = void, typename Selector, typename R = Details::SelectResultT<S, Selector, T>>
+		Observable<R> Select( Selector selector ) const
 		{
-			Vectorable ret( data_.size() );
-			auto itr = ::std::cbegin( data_ );
-			::std::advance( itr, advance );
-			::std::rotate_copy( ::std::cbegin( data_ ), itr, ::std::cend( data_ ), ::std::begin( ret.data_ ) );
-			return ::std::move( ret );
+			Observable<R> ret( ::std::make_shared<Details::Subject<R>>(), windowed_, ordered_ );
+			subject_->Subscribe( ::std::make_shared<Details::SelectObserver<T, R, Selector>>( ret.subject_, selector, windowed_ ) );
+			return ret;
 		}
 
-		constexpr Vectorable OrderBy() const
+		Observable Distinct() const
 		{
-			Vectorable ret( data_.size() );
-			::std::copy( ::std::cbegin( data_ ), ::std::cend( data_ ), ::std::rbegin( ret.data_ ) );
-			::std::sort( ::std::begin( ret.data_ ), ::std::end( ret.data_ ) );
-			return ::std::move( ret );
+			return Distinct( ::std::hash<T>(), ::std::equal_to<T>() );
 		}
-		constexpr Vectorable OrderBy( ::std::function<bool( T, T )> predicate ) const
+		template<typename Hash, typename KeyEqual>
+		Observable Distinct( Hash hash, KeyEqual equal ) const
 		{
-			Vectorable ret( data_.size() );
-			::std::copy( ::std::cbegin( data_ ), ::std::cend( data_ ), ::std::rbegin( ret.data_ ) );
-			::std::sort( ::std::begin( ret.data_ ), ::std::end( ret.data_ ), predicate );
-			return ::std::move( ret );
+			// Behind a Window, a value expires when its last occurrence goes, which is not in the order of the values.
+			Observable ret( ::std::make_shared<Details::Subject<T>>(), windowed_, !windowed_ );
+			subject_->Subscribe( ::std::make_shared<Details::DistinctObserver<T, Hash, KeyEqual>>( ret.subject_, hash, equal ) );
+			return ret;
 		}
 
-		constexpr Vectorable OrderByDescending() const
+		// The last size values: the stages after it see each value come in, and later expire.
+		Observable Window( SizeType size ) const
 		{
-			Vectorable ret( data_.size() );
-			::std::copy( ::std::cbegin( data_ ), ::std::cend( data_ ), ::std::rbegin( ret.data_ ) );
-			::std::sort( ::std::begin( ret.data_ ), ::std::end( ret.data_ ), ::std::greater<>() );
-			return ::std::move( ret );
+			if( size == 0 )
+			{
+				OUTOFRANGEEX
+			}
+
+			Observable ret( ::std::make_shared<Details::Subject<T>>(), true, ordered_ );
+			subject_->Subscribe( ::std::make_shared<Details::WindowObserver<T>>( ret.subject_, size ) );
+			return ret;
 		}
 
 #pragma endregion
 
-#pragma region Set Calc
+#pragma region Basic Calc
 
-		constexpr Vectorable Distinct() const
+		Observed<SizeType> Count() const
 		{
-			Vectorable ret( data_.size() );
-			auto itr = ::std::unique_copy( ::std::cbegin( data_ ), ::std::cend( data_ ), ::std::begin( ret.data_ ) );
-			ret.data_.resize( ::std::distance( ::std::begin( ret.data_ ), itr ) );
-			return ::std::move( ret );
+			return Aggregate<SizeType>( ::std::make_shared<Details::CountAggregator<T>>() );
 		}
-		constexpr Vectorable Distinct( ::std::function<bool( T )> predicate ) const
+
+		Observed<T> Sum() const
 		{
-			Vectorable ret( data_.size() );
-			auto itr = ::std::unique_copy( ::std::cbegin( data_ ), ::std::cend( data_ ), ::std::begin( ret.data_ ), predicate );
-			ret.data_.resize( ::std::distance( ::std::begin( ret.data_ ), itr ) );
-			return ::std::move( ret );
+			ARITHMETICABLECHECK
+
+			return Aggregate<T>( ::std::make_shared<Details::SumAggregator<T, false>>() );
 		}
 
-		constexpr Vectorable Concat( Vectorable second ) const
+		Observed<T> Average() const
 		{
-			Vectorable ret( data_.size() + second.Count() );
-			auto itr = ::std::copy( ::std::cbegin( data_ ), ::std::cend( data_ ), ::std::rbegin( ret.data_ ) );
-			::std::copy( ::std::cbegin( second.data_ ), ::std::cend( second.data_ ), itr );
-			return ::std::move( ret );
+			ARITHMETICABLECHECK
+
+			return Aggregate<T>( ::std::make_shared<Details::SumAggregator<T, true>>() );
 		}
 
-		constexpr Vectorable Except( Vectorable second ) const
+		Observed<T> Minimum() const
 		{
-			Vectorable ret( data_.size() );
-			auto sortedFirst = OrderBy();
-			auto sortedSecond = second.OrderBy();
-			::std::set_difference(
-				::std::cbegin( sortedFirst.data_ ),
-				::std::cend( sortedFirst.data_ ),
-				::std::cbegin( sortedSecond.data_ ),
-				::std::cend( sortedSecond.data_ ),
-				::std::inserter( ret.data_, ::std::begin( ret.data_ ) ) );
-			return ::std::move( ret );
-		}
-		constexpr Vectorable Except( Vectorable second, ::std::function<bool( T, T )> predicate ) const
-		{
-			Vectorable ret( data_.size() );
-			auto sortedFirst = OrderBy();
-			auto sortedSecond = second.OrderBy();
-			::std::set_difference(
-				::std::cbegin( sortedFirst.data_ ),
-				::std::cend( sortedFirst.data_ ),
-				::std::cbegin( sortedSecond.data_ ),
-				::std::cend( sortedSecond.data_ ),
-				::std::inserter( ret.data_, ::std::begin( ret.data_ ) ),
-				predicate );
-			return ::std::move( ret );
+			ARITHMETICABLECHECK
+
+			return Aggregate<T>( ::std::make_shared<Details::ExtremeAggregator<T, ::std::less<T>>>( windowed_, ordered_ ) );
 		}
-		constexpr Vectorable Differ( Vectorable second ) const { return Except( second ); }
-		constexpr Vectorable Differ( Vectorable second, ::std::function<bool( T, T )> predicate ) const { return Except( second, predicate ); }
 
-		constexpr Vectorable Union( Vectorable second ) const
+		Observed<T> Maximum() const
 		{
-			Vectorable ret( data_.size() );
-			auto sortedFirst = OrderBy();
-			auto sortedSecond = second.OrderBy();
-			::std::set_union(
-				::std::cbegin( sortedFirst.data_ ),
-				::std::cend( sortedFirst.data_ ),
-				::std::cbegin( sortedSecond.data_ ),
-				::std::cend( sortedSecond.data_ ),
-				::std::back_inserter( ret.data_ ) );
-			return ::std::move( ret );
-		}
-		constexpr Vectorable Union( Vectorable second, ::std::function<bool( T, T )> predicate ) const
-		{
-			Vectorable ret( data_.size() );
-			auto sortedFirst = OrderBy();
-			auto sortedSecond = second.OrderBy();
-			::std::set_union(
-				::std::cbegin( sortedFirst.data_ ),
-				::std::cend( sortedFirst.data_ ),
-				::std::cbegin( sortedSecond.data_ ),
-				::std::cend( sortedSecond.data_ ),
-				::std::back_inserter( ret.data_ ),
-				predicate );
-			return ::std::move( ret );
+			ARITHMETICABLECHECK
+
+			return Aggregate<T>( ::std::make_shared<Details::ExtremeAggregator<T, ::std::greater<T>>>( windowed_, ordered_ ) );
 		}
 
-		constexpr Vectorable Intersect( Vectorable second ) const
+#pragma endregion
+
+	private:
+		Observable( ::std::shared_ptr<Details::Subject<T>> subject, bool windowed, bool ordered )
+			: subject_( ::std::move( subject ) )
+			, windowed_( windowed )
+			, ordered_( ordered )
+		{ }
+
+		template<typename R, typename Aggregator>
+		Observed<R> Aggregate( ::std::shared_ptr<Aggregator> aggregator ) const
 		{
-			Vectorable ret( data_.size() );
-			auto sortedFirst = OrderBy();
-			auto sortedSecond = second.OrderBy();
-			::std::set_difference(
-				::std::cbegin( sortedFirst.data_ ),
-				::std::cend( sortedFirst.data_ ),
-				::std::cbegin( sortedSecond.data_ ),
-				::std::cend( sortedSecond.data_ ),
-				::std::inserter( ret.data_, ::std::begin( ret.data_ ) ) );
-			return ::std::move( ret );
-		}
-		constexpr Vectorable Intersect( Vectorable second, ::std::function<bool( T, T )> predicate ) const
-		{
-			Vectorable ret( data_.size() );
-			auto sortedFirst = OrderBy();
-			auto sortedSecond = second.OrderBy();
-			::std::set_intersection(
-				::std::cbegin( sortedFirst.data_ ),
-				::std::cend( sortedFirst.data_ ),
-				::std::cbegin( sortedSecond.data_ ),
-				::std::cend( sortedSecond.data_ ),
-				::std::back_inserter( ret.data_ ),
-				predicate );
-			return ::std::move( ret );
+			subject_->Subscribe( aggregator );
+			return Observed<R>( ::std::move( aggregator ) );
 		}
 
+	private:
+		::std::shared_ptr<Details::Subject<T>> subject_;
+		bool windowed_;
+		// Whether the expiries come in the order of the values.
+		bool ordered_;
+	};
+
 #pragma endregion
 
-#pragma region Conversion
+#pragma region Async
+
+#ifdef LINQ_HAS_COROUTINES
+	template<typename T> class AsyncEnumerable;
+	template<typename R> class Task;
+	template<typename T> class Channel;
+
+	namespace Details {
+
+		// The thread waiting in Task::Get resumes, one at a time, the coroutines which Channel::Push and Close post to it,
+		// so the query runs on that thread while the producers run on theirs.
+		class AsyncLoop
+		{
+		public:
+			// The loop of the Task::Get running on this thread, if any.
+			static AsyncLoop*& Current()
+			{
+				static thread_local AsyncLoop* current = nullptr;
+				return current;
+			}
+
+			// Resumes consumer on the thread of loop, or right here when there is no loop.
+			static void Resume( AsyncLoop* loop, ::std::coroutine_handle<> consumer )
+			{
+				if( loop != nullptr )
+				{
+					loop->Post( consumer );
+				}
+				else
+				{
+					consumer.resume();
+				}
+			}
+
+			void Post( ::std::coroutine_handle<> consumer )
+			{
+				{
+					::std::lock_guard<::std::mutex> lock( mutex_ );
+					posted_.push_back( consumer );
+				}
+				wake_.notify_one();
+			}
+
+			// Starts task and sleeps between the posted resumptions until it is done.
+			void Run( ::std::coroutine_handle<> task )
+			{
+				const auto previous = ::std::exchange( Current(), this );
+				task.resume();
+				while( !task.done() )
+				{
+					::std::unique_lock<::std::mutex> lock( mutex_ );
+					wake_.wait( lock, [this] { return !posted_.empty(); } );
+					const auto next = posted_.front();
+					posted_.pop_front();
+					lock.unlock();
+					next.resume();
+				}
+				Current() = previous;
+			}
+
+		private:
+			::std::mutex mutex_;
+			::std::condition_variable wake_;
+			::std::deque<::std::coroutine_handle<>> posted_;
+		};
+
+		// The final and the co_yield suspension of a coroutine: control goes straight to the coroutine waiting for it, if any.
+		struct ResumeAwaiter
+		{
+			::std::coroutine_handle<> next;
+
+			constexpr bool await_ready() const noexcept { return false; }
+			::std::coroutine_handle<> await_suspend( ::std::coroutine_handle<> ) const noexcept { return next ? next : ::std::noop_coroutine(); }
+			constexpr void await_resume() const noexcept { }
+		};
+
+		template<typename R>
+		struct TaskResult
+		{
+			void return_value( R value ) { result.emplace( ::std::move( value ) ); }
+
+			R Result()
+			{
+				if( error )
+				{
+					::std::rethrow_exception( error );
+				}
+				return ::std::move( *result );
+			}
+
+			::std::optional<R> result;
+			::std::exception_ptr error;
+		};
+
+		template<>
+		struct TaskResult<void>
+		{
+			void return_void() { }
+
+			void Result()
+			{
+				if( error )
+				{
+					::std::rethrow_exception( error );
+				}
+			}
+
+			::std::exception_ptr error;
+		};
+
+	}
+
+	// The result of a terminal operator of an AsyncEnumerable. Nothing runs until it is co_awaited from another coroutine,
+	// or until Get runs it on the calling thread.
+	template<typename R>
+	class Task
+	{
+	public:
+		struct promise_type
+			: Details::TaskResult<R>
+		{
+			Task get_return_object() { return Task( ::std::coroutine_handle<promise_type>::from_promise( *this ) ); }
+			::std::suspend_always initial_suspend() const noexcept { return { }; }
+			Details::ResumeAwaiter final_suspend() const noexcept { return { continuation }; }
+			void unhandled_exception() { this->error = ::std::current_exception(); }
+
+			::std::coroutine_handle<> continuation;
+		};
+
+	public:
+		Task( Task&& other ) noexcept
+			: handle_( ::std::exchange( other.handle_, nullptr ) )
+		{ }
+
+		Task& operator=( Task&& ) = delete;
+
+		~Task()
+		{
+			if( handle_ )
+			{
+				handle_.destroy();
+			}
+		}
+
+		auto operator co_await() &&
+		{
+			struct Awaiter
+			{
+				bool await_ready() const noexcept { return false; }
+				::std::coroutine_handle<> await_suspend( ::std::coroutine_handle<> awaiting ) const noexcept
+				{
+					handle.promise().continuation = awaiting;
+					return handle;
+				}
+				R await_resume() const { return handle.promise().Result(); }
+
+				::std::coroutine_handle<promise_type> handle;
+			};
+			return Awaiter { handle_ };
+		}
+
+		// Blocks until the task is done, running it on this thread whenever it is not waiting for a Channel.
+		R Get() &&
+		{
+			Details::AsyncLoop loop;
+			loop.Run( handle_ );
+			return handle_.promise().Result();
+		}
+
+	private:
+		explicit Task( ::std::coroutine_handle<promise_type> handle )
+			: handle_( handle )
+		{ }
+
+	private:
+		::std::coroutine_handle<promise_type> handle_;
+	};
+
+	// A pull-based query over values which arrive over time, e.g. from a Channel. Each operator is a coroutine which co_awaits
+	// the next value of its source only when its own consumer asks for one, so nothing is buffered between the stages and
+	// a Take stops the pulling. Like Enumerable it can be enumerated only once: the operators consume it ( && ).
+	template<typename T>
+	class AsyncEnumerable
+	{
+	public:
+		using SizeType = ::std::size_t;
+
+		struct promise_type
+		{
+			AsyncEnumerable get_return_object() { return AsyncEnumerable( ::std::coroutine_handle<promise_type>::from_promise( *this ) ); }
+			::std::suspend_always initial_suspend() const noexcept { return { }; }
+			Details::ResumeAwaiter final_suspend() const noexcept { return { consumer }; }
+			void unhandled_exception() { error = ::std::current_exception(); }
+			void return_void() const { }
+
+			// The value lives in the suspended coroutine until the consumer asks for the next one.
+			Details::ResumeAwaiter yield_value( const T& value )
+			{
+				current = ::std::addressof( value );
+				return { consumer };
+			}
+
+			const T* current = nullptr;
+			::std::coroutine_handle<> consumer;
+			::std::exception_ptr error;
+		};
+
+	public:
+		AsyncEnumerable( AsyncEnumerable&& other ) noexcept
+			: handle_( ::std::exchange( other.handle_, nullptr ) )
+		{ }
+
+		AsyncEnumerable& operator=( AsyncEnumerable&& ) = delete;
+
+		~AsyncEnumerable()
+		{
+			if( handle_ )
+			{
+				handle_.destroy();
+			}
+		}
+
+		// co_await MoveNext() is true when Current() has the next value, and false at the end.
+		auto MoveNext()
+		{
+			struct Awaiter
+			{
+				bool await_ready() const noexcept { return false; }
+				::std::coroutine_handle<> await_suspend( ::std::coroutine_handle<> consumer ) const noexcept
+				{
+					handle.promise().consumer = consumer;
+					return handle;
+				}
+				bool await_resume() const
+				{
+					if( handle.promise().error )
+					{
+						::std::rethrow_exception( handle.promise().error );
+					}
+					return !handle.done();
+				}
+
+				::std::coroutine_handle<promise_type> handle;
+			};
+			return Awaiter { handle_ };
+		}
+
+		const T& Current() const { return *handle_.promise().current; }
+
+#pragma region Filtering
+
+		template<typename Predicate>
+		AsyncEnumerable Where( Predicate predicate ) &&
+		{
+			return WhereAsync( ::std::move( *this ), ::std::move( predicate ) );
+		}
+
+		template<typename S = void, typename Selector, typename R = Details::SelectResultT<S, Selector, T>>
+		AsyncEnumerable<R> Select( Selector selector ) &&
+		{
+			return SelectAsync<R>( ::std::move( *this ), ::std::move( selector ) );
+		}
 
-#ifdef __cplusplus_winrt
-		template<typename S>
-		constexpr Vectorable<S> Cast() const
+		AsyncEnumerable Take( SizeType count ) &&
 		{
-			return Cast<S>( ::std::integral_constant<bool, __is_valid_winrt_type( T ) && !::std::is_arithmetic<T>::value>() );
+			return TakeAsync( ::std::move( *this ), count );
 		}
 
-		template<typename S>
-		constexpr Vectorable<S> Cast( ::std::false_type ) const
+		template<typename Predicate>
+		AsyncEnumerable TakeWhile( Predicate predicate ) &&
 		{
-			return Select<S>( []( T value ) { return static_cast<S>( value ); } );
+			return TakeWhileAsync( ::std::move( *this ), ::std::move( predicate ) );
 		}
 
-		template<typename S>
-		constexpr Vectorable<S> Cast( ::std::true_type ) const
+		AsyncEnumerable Skip( SizeType count ) &&
 		{
-			static_assert( __is_valid_winrt_type( typename Details::Wrap<T>::type ), "T is winrt type only." );
+			return SkipAsync( ::std::move( *this ), count );
+		}
 
-			return Select<S>( []( T value ) { return dynamic_cast<S>( value ); } );
+#pragma endregion
+
+#pragma region Basic Calc
+
+		Task<SizeType> Count() &&
+		{
+			return CountAsync( ::std::move( *this ), []( const T& ) { return true; } );
 		}
-#else
-		template<typename S>
-		constexpr Vectorable<S> Cast() const
+		template<typename Predicate>
+		Task<SizeType> Count( Predicate predicate ) &&
 		{
-			return Select<S>( []( T value ) { return static_cast<S>( value ); } );
+			return CountAsync( ::std::move( *this ), ::std::move( predicate ) );
 		}
-#endif
 
-		constexpr Vectorable Square() const
+		Task<T> Sum() &&
 		{
 			ARITHMETICABLECHECK
 
-			return Select( Details::Power2<T> );
+			return SumAsync( ::std::move( *this ) );
 		}
 
-		constexpr Vectorable Select( ::std::function<T( T )> selector ) const
+		// Calls action( value ) for every value, until it returns false (when it returns bool).
+		template<typename Action>
+		Task<void> ForEach( Action action ) &&
 		{
-			Vectorable ret( data_.size() );
-			::std::transform(
-				::std::cbegin( data_ ),
-				::std::cend( data_ ),
-				ret.Begin(),
-				[selector]( typename Details::Wrap<T>::type value ) { return Details::MakeWrap( selector( Details::Unwrap( value ) ) ); } );
-			return ::std::move( ret );
+			return ForEachAsync( ::std::move( *this ), ::std::move( action ) );
 		}
-		template<typename S>
-		constexpr Vectorable<S> Select( ::std::function<S( T )> selector ) const
+
+		Task<::std::vector<T>> to_vector() &&
 		{
-			Vectorable<S> ret( data_.size() );
-			::std::transform(
-				::std::cbegin( data_ ),
-				::std::cend( data_ ),
-				ret.Begin(),
-				[selector]( typename Details::Wrap<T>::type value ) { return Details::MakeWrap( selector( Details::Unwrap( value ) ) ); } );
-			return ::std::move( ret );
+			return ToVectorAsync( ::std::move( *this ) );
 		}
 
 #pragma endregion
 
-#pragma region Vectorlize/Maplize
+	private:
+		explicit AsyncEnumerable( ::std::coroutine_handle<promise_type> handle )
+			: handle_( handle )
+		{ }
 
-#if defined( _VECTOR_ ) || defined( _LIBCPP_VECTOR ) || defined( _STLP_VECTOR ) || defined( _GLIBCXX_VECTOR )
-		constexpr ::std::vector<T> to_vector() const
+		// The result of each co_await is stored before it is tested: GCC 12 miscompiles these coroutines when a co_await
+		// is the condition of a loop or an if.
+		template<typename Predicate>
+		static AsyncEnumerable WhereAsync( AsyncEnumerable source, Predicate predicate )
 		{
-			::std::vector<T> ret( data_.size() );
-			::std::transform(
-				::std::cbegin( data_ ),
-				::std::cend( data_ ),
-				::std::begin( ret ),
-				[]( typename Details::Wrap<T>::type value ) { return Details::Unwrap( value ); } );
-			return ::std::move( ret );
+			for( ;; )
+			{
+				const bool more = co_await source.MoveNext();
+				if( !more )
+				{
+					break;
+				}
+				if( predicate( source.Current() ) )
+				{
+					co_yield source.Current();
+				}
+			}
 		}
-		template<typename S> constexpr ::std::vector<T> to_vector( ::std::function<S( T )> selector ) const { return Select<S>( selector ).to_vector(); }
-#endif
 
-#if defined( _DEQUE_ ) || defined( _LIBCPP_DEQUE ) || defined( _STLP_DEQUE ) || defined( _GLIBCXX_DEQUE )
-		constexpr ::std::deque<T> to_deque() const
+		template<typename R, typename Selector>
+		static AsyncEnumerable<R> SelectAsync( AsyncEnumerable source, Selector selector )
 		{
-			::std::deque<T> ret( data_.size() );
-			::std::transform(
-				::std::cbegin( data_ ),
-				::std::cend( data_ ),
-				::std::begin( ret ),
-				[]( typename Details::Wrap<T>::type value ) { return Details::Unwrap( value ); } );
-			return ::std::move( ret );
+			for( ;; )
+			{
+				const bool more = co_await source.MoveNext();
+				if( !more )
+				{
+					break;
+				}
+				co_yield static_cast<R>( selector( source.Current() ) );
+			}
 		}
-		template<typename S> constexpr ::std::deque<T> to_deque( ::std::function<S( T )> selector ) const { return Select<S>( selector ).to_deque(); }
-#endif
 
-#if defined( _LIST_ ) || defined( _LIBCPP_LIST ) || defined( _STLP_LIST ) || defined( _GLIBCXX_LIST )
-		constexpr ::std::list<T> to_list() const
+		static AsyncEnumerable TakeAsync( AsyncEnumerable source, SizeType count )
 		{
-			::std::list<T> ret( data_.size() );
-			::std::transform(
-				::std::cbegin( data_ ),
-				::std::cend( data_ ),
-				::std::begin( ret ),
-				[]( typename Details::Wrap<T>::type value ) { return Details::Unwrap( value ); } );
-			return ::std::move( ret );
+			for( SizeType i = 0; i < count; ++i )
+			{
+				const bool more = co_await source.MoveNext();
+				if( !more )
+				{
+					break;
+				}
+				co_yield source.Current();
+			}
 		}
-		template<typename S> constexpr ::std::list<T> to_list( ::std::function<S( T )> selector ) const { return Select<S>( selector ).to_list(); }
-#endif
 
-#if defined( _FORWARD_LIST_ ) || defined( _LIBCPP_FORWARD_LIST ) || defined( _STLP_FORWARD_LIST ) || defined( _GLIBCXX_FORWARD_LIST )
-		constexpr ::std::forward_list<T> to_forward_list() const
+		template<typename Predicate>
+		static AsyncEnumerable TakeWhileAsync( AsyncEnumerable source, Predicate predicate )
 		{
-			::std::forward_list<T> ret( data_.size() );
-			::std::transform(
-				::std::cbegin( data_ ),
-				::std::cend( data_ ),
-				::std::begin( ret ),
-				[]( typename Details::Wrap<T>::type value ) { return Details::Unwrap( value ); } );
-			return ::std::move( ret );
+			for( ;; )
+			{
+				const bool more = co_await source.MoveNext();
+				if( !more || !predicate( source.Current() ) )
+				{
+					break;
+				}
+				co_yield source.Current();
+			}
 		}
-		template<typename S> constexpr ::std::forward_list<T> to_forward_list( ::std::function<S( T )> selector ) const { return Select<S>( selector ).to_forward_list(); }
-#endif
 
-#if defined( _MAP_ ) || defined( _LIBCPP_MAP ) || defined( _STLP_MAP ) || defined( _GLIBCXX_MAP )
-		template<typename SKey>
-		inline ::std::map<SKey, T> to_map( ::std::function<SKey( T )> selector ) const
+		static AsyncEnumerable SkipAsync( AsyncEnumerable source, SizeType count )
 		{
-			::std::map<SKey, T> ret;
-			::std::for_each(
-				::std::cbegin( data_ ),
-				::std::cend( data_ ),
-				[&ret, selector]( typename Details::Wrap<T>::type value )
+			for( SizeType i = 0; ; ++i )
+			{
+				const bool more = co_await source.MoveNext();
+				if( !more )
 				{
-					auto unwarppedValue = Details::Unwrap( value );
-					ret.emplace( selector( unwarppedValue ), unwarppedValue );
-				} );
-			return ::std::move( ret );
-		}
-		template<typename SKey, typename SValue>
-		inline ::std::map<SKey, SValue> to_map( ::std::function<SKey( T )> keySelector, ::std::function<SValue( T )> valueSelector ) const
-		{
-			::std::map<SKey, SValue> ret;
-			::std::for_each(
-				::std::cbegin( data_ ),
-				::std::cend( data_ ),
-				[&ret, keySelector, valueSelector]( typename Details::Wrap<T>::type value )
+					break;
+				}
+				if( i >= count )
 				{
-					auto unwarppedValue = Details::Unwrap( value );
-					ret.emplace( keySelector( unwarppedValue ), valueSelector( unwarppedValue ) );
-				} );
-			return ::std::move( ret );
+					co_yield source.Current();
+				}
+			}
 		}
 
-		template<typename SKey>
-		inline ::std::multimap<SKey, T> to_multimap( ::std::function<SKey( T )> selector ) const
+		template<typename Predicate>
+		static Task<SizeType> CountAsync( AsyncEnumerable source, Predicate predicate )
 		{
-			::std::multimap<SKey, T> ret;
-			::std::for_each(
-				::std::cbegin( data_ ),
-				::std::cend( data_ ),
-				[&ret, selector]( typename Details::Wrap<T>::type value )
+			SizeType ret = 0;
+			for( ;; )
+			{
+				const bool more = co_await source.MoveNext();
+				if( !more )
 				{
-					auto unwarppedValue = Details::Unwrap( value );
-					ret.emplace( selector( unwarppedValue ), unwarppedValue );
-				} );
-			return ::std::move( ret );
-		}
-		template<typename SKey, typename SValue>
-		inline ::std::multimap<SKey, SValue> to_multimap( ::std::function<SKey( T )> keySelector, ::std::function<SValue( T )> valueSelector ) const
-		{
-			::std::multimap<SKey, SValue> ret;
-			::std::for_each(
-				::std::cbegin( data_ ),
-				::std::cend( data_ ),
-				[&ret, keySelector, valueSelector]( typename Details::Wrap<T>::type value )
+					break;
+				}
+				if( predicate( source.Current() ) )
 				{
-					auto unwarppedValue = Details::Unwrap( value );
-					ret.emplace( keySelector( unwarppedValue ), valueSelector( unwarppedValue ) );
-				} );
-			return ::std::move( ret );
+					++ret;
+				}
+			}
+			co_return ret;
 		}
-#endif
 
-#if defined( _UNORDERED_MAP_ ) || defined(  _LIBCPP_UNORDERED_MAP ) || defined( _STLP_UNORDERED_MAP ) || defined( _GLIBCXX_UNORDERED_MAP )
-		template<typename SKey>
-		constexpr ::std::unordered_map<SKey, T> to_unordered_map( ::std::function<SKey( T )> selector ) const
-		{
-			::std::unordered_map<SKey, T> ret;
-			::std::for_each(
-				::std::cbegin( data_ ),
-				::std::cend( data_ ),
-				[&ret, selector]( typename Details::Wrap<T>::type value )
-				{
-					auto unwarppedValue = Details::Unwrap( value );
-					ret.emplace( selector( unwarppedValue ), unwarppedValue );
-				} );
-			return ::std::move( ret );
-		}
-		template<typename SKey, typename SValue>
-		constexpr::std::unordered_map<SKey, SValue> to_unordered_map( ::std::function<SKey( T )> keySelector, ::std::function<SValue( T )> valueSelector ) const
+		static Task<T> SumAsync( AsyncEnumerable source )
 		{
-			::std::unordered_map<SKey, SValue> ret;
-			::std::for_each(
-				::std::cbegin( data_ ),
-				::std::cend( data_ ),
-				[&ret, keySelector, valueSelector]( typename Details::Wrap<T>::type value )
+			T ret = 0;
+			for( ;; )
+			{
+				const bool more = co_await source.MoveNext();
+				if( !more )
 				{
-					auto unwarppedValue = Details::Unwrap( value );
-					ret.emplace( keySelector( unwarppedValue ), valueSelector( unwarppedValue ) );
-				} );
-			return ::std::move( ret );
+					break;
+				}
+				ret += source.Current();
+			}
+			co_return ret;
 		}
 
-		template<typename SKey>
-		constexpr ::std::unordered_multimap<SKey, T> to_unordered_multimap( ::std::function<SKey( T )> selector ) const
+		template<typename Action>
+		static Task<void> ForEachAsync( AsyncEnumerable source, Action action )
 		{
-			::std::unordered_multimap<SKey, T> ret;
-			::std::for_each(
-				::std::cbegin( data_ ),
-				::std::cend( data_ ),
-				[&ret, selector]( typename Details::Wrap<T>::type value )
+			for( ;; )
+			{
+				const bool more = co_await source.MoveNext();
+				if( !more || !Details::Push( action, source.Current() ) )
 				{
-					auto unwarppedValue = Details::Unwrap( value );
-					ret.emplace( selector( unwarppedValue ), unwarppedValue );
-				} );
-			return ::std::move( ret );
+					break;
+				}
+			}
 		}
-		template<typename SKey, typename SValue>
-		constexpr::std::unordered_multimap<SKey, SValue> to_unordered_multimap( ::std::function<SKey( T )> keySelector, ::std::function<SValue( T )> valueSelector ) const
+
+		static Task<::std::vector<T>> ToVectorAsync( AsyncEnumerable source )
 		{
-			::std::unordered_multimap<SKey, SValue> ret;
-			::std::for_each(
-				::std::cbegin( data_ ),
-				::std::cend( data_ ),
-				[&ret, keySelector, valueSelector]( typename Details::Wrap<T>::type value )
+			::std::vector<T> ret;
+			for( ;; )
+			{
+				const bool more = co_await source.MoveNext();
+				if( !more )
 				{
-					auto unwarppedValue = Details::Unwrap( value );
-					ret.emplace( keySelector( unwarppedValue ), valueSelector( unwarppedValue ) );
-				} );
-			return ::std::move( ret );
+					break;
+				}
+				ret.push_back( source.Current() );
+			}
+			co_return ret;
 		}
-#endif
 
-#ifdef _COLLECTION_H_
-		constexpr ::Windows::Foundation::Collections::IVector<T>^ ToVector() const
+	private:
+		::std::coroutine_handle<promise_type> handle_;
+	};
+
+	// A bounded buffer from producer threads to one AsyncEnumerable (FromChannel). Push blocks while the buffer is full,
+	// which holds a fast producer back to the pace of the query, and the query is suspended, not spinning, while it is empty.
+	template<typename T>
+	class Channel
+	{
+	public:
+		explicit Channel( ::std::size_t capacity )
+			: capacity_( ::std::max( capacity, static_cast<::std::size_t>( 1 ) ) )
+			, closed_( false )
+		{ }
+
+		Channel( const Channel& ) = delete;
+		Channel& operator=( const Channel& ) = delete;
+
+		// False, and value is dropped, when the channel has been closed.
+		bool Push( T value )
 		{
-			return ref new ::Platform::Collections::Vector<T>( ::std::move( to_vector() ) );
+			::std::unique_lock<::std::mutex> lock( mutex_ );
+			notFull_.wait( lock, [this] { return buffer_.size() < capacity_ || closed_; } );
+			if( closed_ )
+			{
+				return false;
+			}
+			buffer_.push_back( ::std::move( value ) );
+			Wake( lock );
+			return true;
 		}
-		template<typename S> constexpr ::Windows::Foundation::Collections::IVector<S>^ ToVector( ::std::function<S( T )> selector ) const { return Select<S>( selector ).ToVector(); }
 
-		constexpr ::Windows::Foundation::Collections::IVectorView<T>^ ToVectorView() const
+		// The query ends after the values in the buffer, and the blocked and later Push calls return false.
+		void Close()
 		{
-			return ref new ::Platform::Collections::VectorView<T>( ::std::move( to_vector() ) );
+			::std::unique_lock<::std::mutex> lock( mutex_ );
+			closed_ = true;
+			notFull_.notify_all();
+			Wake( lock );
 		}
-		template<typename S> constexpr ::Windows::Foundation::Collections::IVectorView<S>^ ToVectorView( ::std::function<S( T )> selector ) const { return Select<S>( selector ).ToVectorView(); }
 
-#ifdef VECTOR_EXTENSION
-		constexpr::Windows::Foundation::Collections::IVector<T>^ ToDeque() const
+		// co_await Receive() is the next value, or nullopt once the channel is closed and empty.
+		auto Receive()
 		{
-			return ref new ::Platform::Collections::Vector<T>( ::std::move( to_deque() ) );
+			struct Awaiter
+			{
+				bool await_ready() const
+				{
+					::std::lock_guard<::std::mutex> lock( channel.mutex_ );
+					return !channel.buffer_.empty() || channel.closed_;
+				}
+				bool await_suspend( ::std::coroutine_handle<> consumer ) const
+				{
+					::std::lock_guard<::std::mutex> lock( channel.mutex_ );
+					if( !channel.buffer_.empty() || channel.closed_ )
+					{
+						return false;
+					}
+					channel.consumer_ = consumer;
+					channel.loop_ = Details::AsyncLoop::Current();
+					return true;
+				}
+				::std::optional<T> await_resume() const
+				{
+					::std::lock_guard<::std::mutex> lock( channel.mutex_ );
+					if( channel.buffer_.empty() )
+					{
+						return ::std::nullopt;
+					}
+					::std::optional<T> ret( ::std::move( channel.buffer_.front() ) );
+					channel.buffer_.pop_front();
+					channel.notFull_.notify_one();
+					return ret;
+				}
+
+				Channel& channel;
+			};
+			return Awaiter { *this };
 		}
-		template<typename S> constexpr::Windows::Foundation::Collections::IVector<S>^ ToDeque( ::std::function<S( T )> selector ) const { return Select<S>( selector ).ToDeque(); }
 
-		constexpr::Windows::Foundation::Collections::IVectorView<T>^ ToDequeView() const
+	private:
+		// Resumes the waiting consumer, if any, after unlocking.
+		void Wake( ::std::unique_lock<::std::mutex>& lock )
 		{
-			return ref new ::Platform::Collections::VectorView<T>( ::std::move( to_deque() ) );
+			const auto consumer = ::std::exchange( consumer_, nullptr );
+			const auto loop = loop_;
+			lock.unlock();
+			if( consumer )
+			{
+				Details::AsyncLoop::Resume( loop, consumer );
+			}
 		}
-		template<typename S> constexpr::Windows::Foundation::Collections::IVectorView<S>^ ToDequeView( ::std::function<S( T )> selector ) const { return Select<S>( selector ).ToDequeView(); }
+
+	private:
+		const ::std::size_t capacity_;
+		::std::mutex mutex_;
+		::std::condition_variable notFull_;
+		::std::deque<T> buffer_;
+		bool closed_;
+		::std::coroutine_handle<> consumer_;
+		Details::AsyncLoop* loop_ = nullptr;
+	};
 #endif
 
-		template<typename SKey>
-		constexpr ::Windows::Foundation::Collections::IMap<SKey, T>^ ToMap( ::std::function<SKey( T )> selector ) const
+#pragma endregion
+
+	template<typename T>
+	using RemoveIteratorT = ::std::remove_const_t<::std::remove_reference_t<::std::remove_const_t<T>>>;
+
+	namespace Details {
+
+		template<typename T, class Container>
+		constexpr Vectorable<T> FromContainer( const Container& container, ::std::true_type )
 		{
-			return ref new ::Platform::Collections::Map<SKey, T>( ::std::move( to_map( selector ) ) );
+			return Vectorable<T>(
+				DataOf( container ),
+				static_cast<typename Vectorable<T>::SizeType>( ::std::distance( ::std::cbegin( container ), ::std::cend( container ) ) ),
+				BorrowTag() );
 		}
 
-		template<typename SKey, typename SValue>
-		constexpr ::Windows::Foundation::Collections::IMap<SKey, SValue>^ ToMap( ::std::function<SKey( T )> keySelector, ::std::function<SValue( T )> valueSelector ) const
+		template<typename T, class Container>
+		constexpr Vectorable<T> FromContainer( const Container& container, ::std::false_type )
 		{
-			return ref new ::Platform::Collections::Map<SKey, SValue>( ::std::move( to_map( keySelector, valueSelector ) ) );
+			return Vectorable<T>( ::std::cbegin( container ), ::std::cend( container ) );
 		}
 
-		template<typename SKey>
-		constexpr ::Windows::Foundation::Collections::IMapView<SKey, T>^ ToMapView( ::std::function<SKey( T )> selector ) const
+		template<typename T, class Container, typename Allocator>
+		constexpr Vectorable<T, Allocator> FromContainer( const Container& container, const Allocator& allocator, ::std::true_type )
 		{
-			return ref new ::Platform::Collections::MapView<SKey, T>( ::std::move( to_map( selector ) ) );
+			return Vectorable<T, Allocator>(
+				DataOf( container ),
+				static_cast<typename Vectorable<T, Allocator>::SizeType>( ::std::distance( ::std::cbegin( container ), ::std::cend( container ) ) ),
+				BorrowTag(),
+				allocator );
 		}
 
-		template<typename SKey, typename SValue>
-		constexpr ::Windows::Foundation::Collections::IMapView<SKey, SValue>^ ToMapView( ::std::function<SKey( T )> keySelector, ::std::function<SValue( T )> valueSelector ) const
+		template<typename T, class Container, typename Allocator>
+		constexpr Vectorable<T, Allocator> FromContainer( const Container& container, const Allocator& allocator, ::std::false_type )
 		{
-			return ref new ::Platform::Collections::MapView<SKey, SValue>( ::std::move( to_map( keySelector, valueSelector ) ) );
+			return Vectorable<T, Allocator>( ::std::cbegin( container ), ::std::cend( container ), allocator );
 		}
 
-		template<typename SKey>
-		constexpr ::Windows::Foundation::Collections::IMap<SKey, T>^ ToUnorderedMap( ::std::function<SKey( T )> selector ) const
+	}
+
+	// Contiguous containers (vector, array, string, built-in arrays, ...) are borrowed, not copied;
+	// the container must outlive the returned Vectorable. Results of operators own their elements.
+	template<class Container>
+	constexpr auto From( const Container& container ) -> Vectorable<RemoveIteratorT<decltype( *::std::begin( container ) )>>
+	{
+		using T = RemoveIteratorT<decltype( *::std::begin( container ) )>;
+		return Details::FromContainer<T>(
+			container,
+			::std::integral_constant<bool, Details::IsContiguous<Container>::value && ::std::is_same<typename Details::Wrap<T>::type, T>::value>() );
+	}
+
+	// Like From( container ), but the results of the operators allocate from allocator (rebound to the element type),
+	// e.g. an ArenaAllocator or a ::std::pmr::polymorphic_allocator.
+	template<class Container, typename Allocator>
+	constexpr auto From( const Container& container, const Allocator& allocator )
+		-> Vectorable<RemoveIteratorT<decltype( *::std::begin( container ) )>, Details::RebindAllocatorT<Allocator, RemoveIteratorT<decltype( *::std::begin( container ) )>>>
+	{
+		using T = RemoveIteratorT<decltype( *::std::begin( container ) )>;
+		return Details::FromContainer<T>(
+			container,
+			Details::RebindAllocatorT<Allocator, T>( allocator ),
+			::std::integral_constant<bool, Details::IsContiguous<Container>::value && ::std::is_same<typename Details::Wrap<T>::type, T>::value>() );
+	}
+
+	// Temporaries cannot be borrowed, so their elements are copied (or moved, for a vector).
+	template<class Container, typename = ::std::enable_if_t<!::std::is_lvalue_reference<Container>::value>>
+	constexpr auto From( Container&& container ) -> Vectorable<RemoveIteratorT<decltype( *::std::begin( container ) )>>
+	{
+		return Vectorable<RemoveIteratorT<decltype( *::std::begin( container ) )>>( ::std::cbegin( container ), ::std::cend( container ) );
+	}
+	template<typename T, typename = ::std::enable_if_t<::std::is_same<typename Details::Wrap<T>::type, T>::value>>
+	constexpr Vectorable<T> From( ::std::vector<T>&& container )
+	{
+		return Vectorable<T>( ::std::move( container ) );
+	}
+
+	template<class Container>
+	constexpr auto AsEnumerable( const Container& container )
+		-> Enumerable<RemoveIteratorT<decltype( *::std::begin( container ) )>, Details::IteratorEnumerator<decltype( ::std::cbegin( container ) )>>
+	{
+		return Enumerable<RemoveIteratorT<decltype( *::std::begin( container ) )>, Details::IteratorEnumerator<decltype( ::std::cbegin( container ) )>>(
+			Details::IteratorEnumerator<decltype( ::std::cbegin( container ) )>( ::std::cbegin( container ), ::std::cend( container ) ) );
+	}
+	template<class Container> void AsEnumerable( const Container&& ) = delete;
+
+	// Parses whitespace separated elements with operator>> while they are pulled, blockSize at a time.
+	// Where, Select, Count, Sum, Any, First and so on run in O( blockSize ) memory; OrderBy, Reverse, Median and
+	// ToVectorable read the rest of the stream into memory. The stream must outlive the query, which can be enumerated only once.
+	// A token which is not a T throws runtime_error when it is reached.
+	template<typename T>
+	inline Enumerable<T, Details::StreamEnumerator<T, Details::ExtractReader>> FromStream( ::std::istream& stream, ::std::size_t blockSize = 4096 )
+	{
+		return Enumerable<T, Details::StreamEnumerator<T, Details::ExtractReader>>(
+			Details::StreamEnumerator<T, Details::ExtractReader>( stream, blockSize, Details::ExtractReader() ) );
+	}
+
+	// Like FromStream, with one element per line (without the line break).
+	inline Enumerable<::std::string, Details::StreamEnumerator<::std::string, Details::LineReader>> FromLines( ::std::istream& stream, ::std::size_t blockSize = 1024 )
+	{
+		return Enumerable<::std::string, Details::StreamEnumerator<::std::string, Details::LineReader>>(
+			Details::StreamEnumerator<::std::string, Details::LineReader>( stream, blockSize, Details::LineReader() ) );
+	}
+
+#ifdef LINQ_HAS_COROUTINES
+	// Queries the values pushed into channel as they arrive. The channel must outlive the query.
+	template<typename T>
+	inline AsyncEnumerable<T> FromChannel( Channel<T>& channel )
+	{
+		for( ;; )
 		{
-			return ref new ::Platform::Collections::UnorderedMap<SKey, T>( ::std::move( to_unordered_map( selector ) ) );
+			auto value = co_await channel.Receive();
+			if( !value )
+			{
+				break;
+			}
+			co_yield *value;
 		}
+	}
+#endif
+
+#ifdef LINQ_HAS_MAPPED_FILE
+	// Maps a file of raw T records and queries it in place. The mapping lives as long as the Vectorable or its copies;
+	// Begin/End and the other mutating calls copy the elements into memory first.
+	template<typename T>
+	inline Vectorable<T> FromMappedFile( const ::std::string& path )
+	{
+		static_assert( ::std::is_trivially_copyable<T>::value, "T must be trivially copyable." );
 
-		template<typename SKey, typename SValue>
-		constexpr ::Windows::Foundation::Collections::IMap<SKey, SValue>^ ToUnorderedMap( ::std::function<SKey( T )> keySelector, ::std::function<SValue( T )> valueSelector ) const
+		auto file = ::std::make_shared<const Details::MappedFile>( path );
+		if( file->Size() % sizeof( T ) != 0 )
 		{
-			return ref new ::Platform::Collections::UnorderedMap<SKey, SValue>( ::std::move( to_unordered_map( keySelector, valueSelector ) ) );
+			throw ::std::runtime_error( path + ": the file size is not a multiple of the element size." );
 		}
+		return Vectorable<T>( reinterpret_cast<const T*>( file->Data() ), file->Size() / sizeof( T ), file );
+	}
+
+	// Maps a snapshot written by Vectorable::to_file. The header is always checked; the checksum, which has to read
+	// the whole file, only when verify is true.
+	template<typename T>
+	inline Vectorable<T> FromSnapshot( const ::std::string& path, bool verify = false )
+	{
+		static_assert( ::std::is_trivially_copyable<T>::value, "T must be trivially copyable." );
 
-		template<typename SKey>
-		constexpr ::Windows::Foundation::Collections::IMapView<SKey, T>^ ToUnorderedMapView( ::std::function<SKey( T )> selector ) const
+		auto file = ::std::make_shared<const Details::MappedFile>( path );
+		Details::SnapshotHeader header;
+		if( file->Size() < sizeof( header ) )
+		{
+			throw ::std::runtime_error( path + ": not a snapshot." );
+		}
+		::std::memcpy( &header, file->Data(), sizeof( header ) );
+		if( ::std::memcmp( header.magic, Details::SnapshotMagic, sizeof( header.magic ) ) != 0 || header.version != Details::SnapshotVersion )
 		{
-			return ref new ::Platform::Collections::UnorderedMapView<SKey, T>( ::std::move( to_unordered_map( selector ) ) );
+			throw ::std::runtime_error( path + ": not a snapshot." );
+		}
+		if( header.elementSize != sizeof( T ) || header.count != ( file->Size() - sizeof( header ) ) / sizeof( T ) || ( file->Size() - sizeof( header ) ) % sizeof( T ) != 0 )
+		{
+			throw ::std::runtime_error( path + ": the element size or the count does not match the file." );
 		}
 
-		template<typename SKey, typename SValue>
-		constexpr ::Windows::Foundation::Collections::IMapView<SKey, SValue>^ ToUnorderedMapView( ::std::function<SKey( T )> keySelector, ::std::function<SValue( T )> valueSelector ) const
+		const auto data = file->Data() + sizeof( header );
+		const auto count = static_cast<::std::size_t>( header.count );
+		if( verify && Details::Checksum( data, count * sizeof( T ) ) != header.checksum )
 		{
-			return ref new ::Platform::Collections::UnorderedMapView<SKey, SValue>( ::std::move( to_unordered_map( keySelector, valueSelector ) ) );
+			throw ::std::runtime_error( path + ": checksum mismatch." );
 		}
+		return Vectorable<T>( reinterpret_cast<const T*>( data ), count, file );
+	}
 #endif
 
-#pragma endregion
+	// The generators are deferred like AsEnumerable and hold no elements: Range( 1, 1000000000 ).Where( p ).Count() runs in O( 1 ) memory.
+	// Call ToVectorable() to materialize one.
+	template<class Integer>
+	constexpr Enumerable<Integer, Details::RangeEnumerator<Integer>> Range( Integer from, Integer to )
+	{
+		static_assert( ::std::is_integral<Integer>::value, "T is integer only." );
 
-	private:
-		::std::vector<typename Details::Wrap<T>::type> data_;
-	};
+		using UnsignedType = ::std::make_unsigned_t<Integer>;
+		const auto count = to < from ? 0 : static_cast<::std::size_t>( static_cast<UnsignedType>( to ) - static_cast<UnsignedType>( from ) ) + 1;
+		return Enumerable<Integer, Details::RangeEnumerator<Integer>>( Details::RangeEnumerator<Integer>( from, count ) );
+	}
 
 	template<typename T>
-	using RemoveIteratorT = ::std::remove_const_t<::std::remove_reference_t<::std::remove_const_t<T>>>;
-
-	template<class Container>
-	constexpr auto From( const Container& container ) -> Vectorable<RemoveIteratorT<decltype( *::std::begin( container ) )>>
+	constexpr Enumerable<T, Details::RepeatEnumerator<T>> Repeat( T element, ::std::size_t count )
 	{
-		return Vectorable<RemoveIteratorT<decltype( *::std::begin( container ) )>>( ::std::cbegin( container ), ::std::cend( container ) );
+		return Enumerable<T, Details::RepeatEnumerator<T>>( Details::RepeatEnumerator<T>( ::std::move( element ), count ) );
 	}
 
-	template<class Integer>
-	constexpr Vectorable<Integer> Range( Integer from, Integer to )
+	// Unbounded sequences: seed, step( seed ), step( step( seed ) ), ... or func(), func(), ...
+	// They have to be ended by Take, TakeWhile or a stopping First / Any / ForEach; Count or OrderBy on them never return.
+	template<typename T, typename Step>
+	constexpr Enumerable<T, Details::IterateEnumerator<T, Step>> Generate( T seed, Step step )
 	{
-		static_assert( ::std::is_integral<Integer>::value, "T is integer only." );
-
-		Vectorable<Integer> ret( to - from + 1 );
-		::std::generate( ret.Begin(), ret.End(), [&from] { return from++; } );
-		return ret;
+		return Enumerable<T, Details::IterateEnumerator<T, Step>>( Details::IterateEnumerator<T, Step>( ::std::move( seed ), ::std::move( step ) ) );
 	}
-
-	template<typename T>
-	constexpr Vectorable<T> Repeat( T element, typename Vectorable<T>::SizeType count )
+	template<typename Func, typename T = ::std::decay_t<Details::InvokeResultT<Func>>>
+	constexpr Enumerable<T, Details::GenerateEnumerator<T, Func>> Generate( Func func )
 	{
-		return Vectorable<T>( element, count );
+		return Enumerable<T, Details::GenerateEnumerator<T, Func>>( Details::GenerateEnumerator<T, Func>( ::std::move( func ) ) );
 	}
 
 }
@@ -912,5 +7188,11 @@ namespace Linq {
 #undef constexpr
 #endif
 
+#undef LINQSIMDX86
 #undef OUTOFRANGEEX
-#undef ARITHMETICABLECHECK
\ No newline at end of file
+#undef ARITHMETICABLECHECK
+#undef LINQINSTRUMENT
+#undef LINQINSTRUMENTIN
+#undef LINQCOUNTED
+#undef LINQINSTRUMENTOUT
+#undef LINQCOUNTEDIN
\ No newline at end of file